@@ -0,0 +1,201 @@
+#include "../Bench/Corpus.hpp"
+#include "../Lexer/Generator.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <format>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(_WIN32)
+#include <Windows.h>
+#include <Psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+// Usage:
+// lexer_bench [--profile NAME] [--size MB] [--seed N] [--runs N] [--jobs N]
+//             [--depth N] [--line-length N] [--string3 RATE] [--numbers RATE] [--comments RATE] [--errors RATE] [--save DIRECTORY]
+// Without --profile every profile is run. The other options change every profile that is run.
+// Every result is the best of --runs runs. Peak RSS is of the whole process so far, so run one profile to compare it.
+
+namespace
+{
+    struct Profile
+    {
+        std::string_view name;
+        Bench::CorpusOptions options;
+    };
+
+    std::vector<Profile> makeProfiles(void)
+    {
+        std::vector<Profile> profiles(7);
+        profiles[0].name = "default";
+        profiles[1].name = "deep";
+        profiles[1].options.maxDepth = 16;
+        profiles[2].name = "long";
+        profiles[2].options.lineLength = 400;
+        profiles[3].name = "strings";
+        profiles[3].options.string3Rate = 0.3;
+        profiles[4].name = "numbers";
+        profiles[4].options.numberRate = 0.95;
+        profiles[5].name = "comments";
+        profiles[5].options.commentRate = 0.5;
+        profiles[6].name = "errors";
+        profiles[6].options.errorRate = 0.3;
+        return profiles;
+    }
+
+    double peakRssMiB(void)
+    {
+#if defined(_WIN32)
+        PROCESS_MEMORY_COUNTERS counters{};
+        if (not K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+        return static_cast<double>(counters.PeakWorkingSetSize) / (1 << 20);
+#else
+        struct rusage usage{};
+        if (::getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#if defined(__APPLE__)
+        return static_cast<double>(usage.ru_maxrss) / (1 << 20); // Bytes.
+#else
+        return static_cast<double>(usage.ru_maxrss) / (1 << 10); // KiB.
+#endif
+#endif
+    }
+
+    template <typename Function>
+    double bestSeconds(std::size_t runs, Function function)
+    {
+        double best = 0;
+        for (std::size_t i = 0; i < runs; i++)
+        {
+            auto start = std::chrono::steady_clock::now();
+            function();
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            if (i == 0 or elapsed.count() < best) best = elapsed.count();
+        }
+        return best;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<Profile> profiles = makeProfiles();
+    std::string_view only;
+    std::size_t runs = 5;
+    std::size_t threadCount = 1;
+    std::filesystem::path saveDirectory;
+
+    // Overrides, applied to every profile.
+    std::vector<std::pair<std::string_view, std::string>> overrides;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string_view flag = argv[i];
+        if (i + 1 >= argc)
+        {
+            std::cerr << "Missing value for " << flag << '\n';
+            return 1;
+        }
+        std::string value = argv[++i];
+
+        if (flag == "--profile") only = argv[i];
+        else if (flag == "--runs") runs = std::max<std::size_t>(1, std::stoul(value));
+        else if (flag == "--jobs") threadCount = std::stoul(value);
+        else if (flag == "--save") saveDirectory = value;
+        else overrides.emplace_back(flag, value);
+    }
+
+    for (Profile& profile : profiles)
+    {
+        Bench::CorpusOptions& options = profile.options;
+        for (const auto& [flag, value] : overrides)
+        {
+            if (flag == "--size") options.size = static_cast<std::size_t>(std::stod(value) * (1 << 20));
+            else if (flag == "--seed") options.seed = std::stoull(value);
+            else if (flag == "--depth") options.maxDepth = std::stoul(value);
+            else if (flag == "--line-length") options.lineLength = std::stoul(value);
+            else if (flag == "--string3") options.string3Rate = std::stod(value);
+            else if (flag == "--numbers") options.numberRate = std::stod(value);
+            else if (flag == "--comments") options.commentRate = std::stod(value);
+            else if (flag == "--errors") options.errorRate = std::stod(value);
+            else
+            {
+                std::cerr << "Unknown option: " << flag << '\n';
+                return 1;
+            }
+        }
+    }
+
+    std::filesystem::path directory = saveDirectory.empty() ? std::filesystem::temp_directory_path() : saveDirectory;
+    std::filesystem::create_directories(directory);
+
+    std::cout << std::format("{:<10}{:>9}{:>12}{:>12}{:>14}{:>10}{:>12}{:>12}{:>9}\n",
+        "profile", "MiB", "tokens", "lex MB/s", "tokens/s", "ns/token", "write MB/s", "RSS MiB", "errors");
+
+    bool found = false;
+    for (const Profile& profile : profiles)
+    {
+        if (not only.empty() and profile.name != only) continue;
+        found = true;
+
+        // The Generator lexes files, so the corpus is written to one first.
+        std::string corpus = Bench::generateCorpus(profile.options);
+        std::filesystem::path input = directory / std::format("lexer_bench_{}.mon", profile.name);
+        std::filesystem::path output = directory / std::format("lexer_bench_{}.lex", profile.name);
+        {
+            std::ofstream stream(input, std::ios::out | std::ios::binary | std::ios::trunc);
+            stream.write(corpus.data(), static_cast<std::streamsize>(corpus.size()));
+            if (not stream)
+            {
+                std::cerr << "Could not write file: " << input.string() << '\n';
+                return 1;
+            }
+        }
+        std::string inputName = input.string();
+
+        // Lex.
+        std::size_t tokensCount = 0;
+        std::size_t errorsCount = 0;
+        double lexSeconds = bestSeconds(runs, [&]
+        {
+            Lexer::Generator lexer(inputName.c_str(), threadCount);
+            tokensCount = lexer.size();
+            errorsCount = lexer.errors().size();
+        });
+
+        // Write.
+        Lexer::Generator lexer(inputName.c_str(), threadCount);
+        std::uintmax_t outputSize = 0;
+        double writeSeconds = bestSeconds(runs, [&]
+        {
+            std::fstream stream(output, std::ios::out | std::ios::trunc);
+            stream << lexer;
+        });
+        outputSize = std::filesystem::file_size(output);
+
+        double megabytes = static_cast<double>(corpus.size()) / 1e6;
+        std::cout << std::format("{:<10}{:>9.2f}{:>12}{:>12.1f}{:>14.0f}{:>10.2f}{:>12.1f}{:>12.1f}{:>9}\n",
+            profile.name, static_cast<double>(corpus.size()) / (1 << 20), tokensCount,
+            megabytes / lexSeconds, static_cast<double>(tokensCount) / lexSeconds, lexSeconds * 1e9 / static_cast<double>(std::max<std::size_t>(1, tokensCount)),
+            static_cast<double>(outputSize) / 1e6 / writeSeconds, peakRssMiB(), errorsCount);
+
+        if (saveDirectory.empty())
+        {
+            std::error_code error;
+            std::filesystem::remove(input, error);
+            std::filesystem::remove(output, error);
+        }
+    }
+
+    if (not found)
+    {
+        std::cerr << "Unknown profile: " << only << '\n';
+        return 1;
+    }
+    return 0;
+}
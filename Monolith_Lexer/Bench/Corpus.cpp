@@ -0,0 +1,205 @@
+#include "../Bench/Corpus.hpp"
+#include <array>
+#include <string_view>
+
+namespace
+{
+    // SplitMix64. Not std::mt19937 with std::uniform_*_distribution, their results change between standard libraries.
+    class Random
+    {
+    public:
+        Random(std::uint64_t seed) : m_state(seed)
+        {
+        }
+
+        std::uint64_t next(void)
+        {
+            std::uint64_t z = (this->m_state += 0x9E3779B97F4A7C15);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+            return z ^ (z >> 31);
+        }
+        std::size_t below(std::size_t count)
+        {
+            return static_cast<std::size_t>(this->next() % count);
+        }
+        bool chance(double rate)
+        {
+            return static_cast<double>(this->next() >> 11) * 0x1.0p-53 < rate;
+        }
+        template <typename T, std::size_t N>
+        const T& pick(const std::array<T, N>& items)
+        {
+            return items[this->below(N)];
+        }
+
+    private:
+        std::uint64_t m_state;
+    };
+
+    constexpr auto names = std::to_array<std::string_view>(
+    {
+        "x", "y", "count", "index", "buffer", "node", "value", "left", "right", "result", "total_size", "item", "parser", "tokens"
+    });
+    constexpr auto types = std::to_array<std::string_view>(
+    {
+        "int8", "uint8", "int16", "uint16", "int32", "uint32", "int64", "uint64", "float", "double"
+    });
+    constexpr auto operators = std::to_array<std::string_view>(
+    {
+        "+", "-", "*", "/", "%", "<<", ">>", "|", "&", "^", "==", "!=", "<=", ">=", "<", ">", "and", "or"
+    });
+    constexpr auto assignments = std::to_array<std::string_view>(
+    {
+        "=", "=", "=", "+=", "-=", "*=", "/=", "<<=", ">>=", "|=", "&="
+    });
+    constexpr auto numbers = std::to_array<std::string_view>(
+    {
+        "0", "7", "1234", "3.14", ".5", "2.", "1e-3", "6.02e23", "0xFF", "0xDEADbeef", "0b1010", "0o755"
+    });
+    constexpr auto atoms = std::to_array<std::string_view>(
+    {
+        "True", "False", "None", "\"Hello, World!\\n\"", "'a'", "'\\n'"
+    });
+    constexpr auto blocks = std::to_array<std::string_view>(
+    {
+        "if", "elif", "while", "for"
+    });
+    // One lexing error each. Only used with errorRate.
+    constexpr auto errors = std::to_array<std::string_view>(
+    {
+        "0xZZ", "0b102", "0o78", "1.2.3", "12ab", "1e+", "'ab'", "\"no end", "$", "@"
+    });
+
+    void appendOperand(std::string& out, Random& random, double numberRate)
+    {
+        if (random.chance(numberRate)) out += random.pick(numbers);
+        else if (random.chance(0.15)) out += random.pick(atoms);
+        else out += random.pick(names);
+    }
+    void appendExpression(std::string& out, Random& random, std::size_t length, double numberRate)
+    {
+        std::size_t start = out.size();
+        appendOperand(out, random, numberRate);
+        while (out.size() - start < length)
+        {
+            out += ' ';
+            out += random.pick(operators);
+            out += ' ';
+            if (random.chance(0.2))
+            {
+                out += random.pick(names);
+                out += '(';
+                appendOperand(out, random, numberRate);
+                out += ", ";
+                appendOperand(out, random, numberRate);
+                out += ')';
+            }
+            else if (random.chance(0.1))
+            {
+                out += random.pick(names);
+                out += '[';
+                appendOperand(out, random, numberRate);
+                out += ']';
+            }
+            else
+            {
+                appendOperand(out, random, numberRate);
+            }
+        }
+    }
+}
+
+std::string Bench::generateCorpus(const Bench::CorpusOptions& options)
+{
+    Random random(options.seed);
+    std::string out;
+    out.reserve(options.size + 1024);
+
+    std::size_t depth = 0;
+    bool isAfterComment = false; // The lexer doesn't check the indention of the line after a comment, so that line keeps the depth.
+    while (out.size() < options.size)
+    {
+        std::string indent(depth * 4, ' ');
+
+        // Comment lines.
+        if (not isAfterComment and random.chance(options.commentRate))
+        {
+            out += indent;
+            out += "# Some comment about ";
+            out += random.pick(names);
+            out += '\n';
+            isAfterComment = true;
+            continue;
+        }
+
+        // Blocks. Every block gets at least one statement, the lexer doesn't care but it looks like real code.
+        if (not isAfterComment and (depth == 0 or (depth < options.maxDepth and random.chance(0.25))))
+        {
+            out += indent;
+            if (depth == 0)
+            {
+                out += "def ";
+                out += random.pick(names);
+                out += "_";
+                out += std::to_string(random.below(1000));
+                out += "(argc: int32, argv: ptr[int8, 2]) -> ";
+                out += random.pick(types);
+            }
+            else
+            {
+                out += random.pick(blocks);
+                out += " (";
+                appendExpression(out, random, options.lineLength / 2, options.numberRate);
+                out += ')';
+            }
+            out += ":\n";
+            depth++;
+            continue;
+        }
+
+        // Statements.
+        out += indent;
+        if (random.chance(options.string3Rate))
+        {
+            out += random.pick(names);
+            out += " = \"\"\"First line of ";
+            out += random.pick(names);
+            out += "\n    second line\n\nlast line\"\"\"";
+        }
+        else if (random.chance(0.1))
+        {
+            out += "return ";
+            appendExpression(out, random, options.lineLength, options.numberRate);
+        }
+        else
+        {
+            out += random.pick(names);
+            out += ' ';
+            out += random.pick(assignments);
+            out += ' ';
+            appendExpression(out, random, options.lineLength, options.numberRate);
+        }
+        bool hasError = random.chance(options.errorRate);
+        if (hasError)
+        {
+            out += " + ";
+            out += random.pick(errors);
+        }
+        bool hasComment = random.chance(options.commentRate);
+        if (hasComment)
+        {
+            out += " # Trailing comment";
+        }
+        out += '\n';
+        isAfterComment = hasError or hasComment; // An error skips the rest of its line like a comment does.
+
+        // Close some blocks.
+        while (not isAfterComment and depth > 0 and random.chance(0.2))
+        {
+            depth--;
+        }
+    }
+
+    return out;
+}
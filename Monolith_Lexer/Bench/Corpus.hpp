@@ -0,0 +1,23 @@
+#pragma once
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+namespace Bench
+{
+	// How the generated Monolith source looks. Rates are chances (0 to 1) per line.
+	// The same options (And seed) always make the same bytes, on every platform and compiler.
+	struct CorpusOptions
+	{
+		std::size_t size = 8 << 20; // Bytes. The corpus stops at the first line after it.
+		std::uint64_t seed = 1;
+		std::size_t maxDepth = 4; // Deepest indention level.
+		std::size_t lineLength = 60; // Rough length of a statement line.
+		double string3Rate = 0.02; // Multi-line """...""" literals.
+		double numberRate = 0.5; // Lines with numeric literals of every kind.
+		double commentRate = 0.1; // Comment lines and comments at the end of lines.
+		double errorRate = 0.0; // Lines with one lexing error.
+	};
+
+	std::string generateCorpus(const Bench::CorpusOptions& options);
+}
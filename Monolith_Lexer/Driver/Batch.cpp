@@ -0,0 +1,136 @@
+#include "../Driver/Batch.hpp"
+#include "../Lexer/Generator.hpp"
+#include "../Helper/ThreadPool.hpp"
+#include "../Helper/Arena.hpp"
+#include <algorithm>
+#include <numeric>
+#include <map>
+#include <fstream>
+#include <format>
+
+Driver::Batch::Batch(const std::filesystem::path& outputDirectory, const std::vector<std::filesystem::path>& inputs, std::size_t threadCount,
+    Lexer::Interner* interner, Lexer::Cache* cache) : m_interner(interner), m_cache(cache)
+{
+    // Collect.
+    for (const std::filesystem::path& input : inputs)
+    {
+        std::error_code error;
+        if (not std::filesystem::is_directory(input, error))
+        {
+            Entry& entry = this->m_entries.emplace_back();
+            entry.input = input.string();
+            entry.output = outputDirectory / input.filename().replace_extension(".lex");
+            continue;
+        }
+
+        // Sorted, so the order doesn't depend on the file system.
+        std::vector<std::filesystem::path> files;
+        for (const auto& file : std::filesystem::recursive_directory_iterator(input, error))
+        {
+            if (file.is_regular_file() and file.path().extension() == ".mon") files.emplace_back(file.path());
+        }
+        std::sort(files.begin(), files.end());
+
+        for (const std::filesystem::path& file : files)
+        {
+            Entry& entry = this->m_entries.emplace_back();
+            entry.input = file.string();
+            entry.output = outputDirectory / std::filesystem::relative(file, input).replace_extension(".lex");
+        }
+    }
+
+    // Two inputs with the same output (Like a/x.mon and b/x.mon given directly) would write one file from two threads at once.
+    // The first one keeps it, the others are errors and are not lexed.
+    std::map<std::filesystem::path, const Entry*> outputs;
+    for (Entry& entry : this->m_entries)
+    {
+        auto [it, isNew] = outputs.emplace(entry.output.lexically_normal(), &entry);
+        if (not isNew) entry.errors.emplace_back(std::format("Same output file as '{}': '{}'", it->second->input, entry.output.string()));
+    }
+
+    // Biggest first. A big file that starts last is what makes the whole batch slow.
+    std::vector<std::size_t> order(this->m_entries.size());
+    std::iota(order.begin(), order.end(), 0);
+    for (Entry& entry : this->m_entries)
+    {
+        std::error_code error;
+        entry.size = std::filesystem::file_size(entry.input, error);
+        if (error) entry.size = 0;
+    }
+    std::stable_sort(order.begin(), order.end(), [this](std::size_t a, std::size_t b) -> bool
+    {
+        return this->m_entries[a].size > this->m_entries[b].size;
+    });
+
+    // Lex.
+    Helper::ThreadPool pool(threadCount);
+    for (std::size_t index : order)
+    {
+        if (not this->m_entries[index].errors.empty()) continue;
+        pool.submit([this, index, interner, cache] { Driver::Batch::lex(this->m_entries[index], interner, cache); });
+    }
+    pool.wait();
+}
+
+bool Driver::Batch::didPass(void) const
+{
+    return std::all_of(this->m_entries.begin(), this->m_entries.end(), [](const Entry& entry) -> bool
+    {
+        return entry.errors.empty();
+    });
+}
+
+void Driver::Batch::lex(Entry& entry, Lexer::Interner* interner, Lexer::Cache* cache)
+{
+    // The tokens and lines of the last file of this thread are done with, so their memory is reused (See Helper::Arena).
+    thread_local Helper::Arena arena;
+    arena.reset();
+    Lexer::Generator lexer(entry.input.c_str(), 1, interner, cache, false, &arena);
+    entry.tokenCount = lexer.size();
+    entry.isCacheHit = lexer.isCacheHit();
+    for (const Lexer::Diagnostic& error : lexer.errors())
+    {
+        entry.errors.emplace_back(error.toString()); // Now, the code of an error points into the source of lexer.
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(entry.output.parent_path(), error);
+    std::fstream output(entry.output, std::ios::out | std::ios::trunc);
+    if (not output)
+    {
+        entry.errors.emplace_back(std::format("Could not write file: '{}'", entry.output.string()));
+        return;
+    }
+    output << lexer;
+}
+
+std::ostream& Driver::operator << (std::ostream& stream, const Driver::Batch& batch)
+{
+    for (const Driver::Batch::Entry& entry : batch.m_entries)
+    {
+        if (entry.errors.empty())
+        {
+            stream << entry.input << ": " << entry.tokenCount << " tokens\n";
+            continue;
+        }
+
+        stream << entry.input << ": " << entry.errors.size() << " errors\n";
+        for (const std::string& error : entry.errors)
+        {
+            stream << error << '\n';
+        }
+    }
+    if (batch.m_interner)
+    {
+        stream << batch.m_interner->size() << " distinct names\n";
+    }
+    if (batch.m_cache)
+    {
+        std::size_t hitsCount = std::count_if(batch.m_entries.begin(), batch.m_entries.end(), [](const Driver::Batch::Entry& entry) -> bool
+        {
+            return entry.isCacheHit;
+        });
+        stream << hitsCount << " of " << batch.m_entries.size() << " files from the cache\n";
+    }
+    return stream;
+}
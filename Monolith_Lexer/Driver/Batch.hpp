@@ -0,0 +1,47 @@
+#pragma once
+#include "../Lexer/Interner.hpp"
+#include "../Lexer/Cache.hpp"
+
+#include <vector>
+#include <string>
+#include <filesystem>
+#include <ostream>
+#include <thread>
+#include <cstdint>
+
+namespace Driver
+{
+	// Lexes many files at once on all cores (See Helper::ThreadPool). Bigger files are started first.
+	// Every file writes its own .lex file into the output directory:
+	// Files given directly keep only their name, files found in a given directory keep their path inside it.
+	// Results are kept in input order, so the summary is the same no matter which thread finished first.
+	// With an interner all the files share it, so a name has the same ID in every file (See Lexer::Interner).
+	// With a cache files that didn't change since they were last lexed are read from it (See Lexer::Cache).
+	class Batch
+	{
+	public:
+		Batch(const std::filesystem::path& outputDirectory, const std::vector<std::filesystem::path>& inputs, std::size_t threadCount = std::thread::hardware_concurrency(),
+			Lexer::Interner* interner = nullptr, Lexer::Cache* cache = nullptr);
+
+		friend std::ostream& operator << (std::ostream& stream, const Driver::Batch& batch);
+
+		bool didPass(void) const;
+
+	private:
+		struct Entry
+		{
+			std::string input;
+			std::filesystem::path output;
+			std::uintmax_t size = 0;
+			std::size_t tokenCount = 0;
+			bool isCacheHit = false;
+			std::vector<std::string> errors;
+		};
+
+		static void lex(Entry& entry, Lexer::Interner* interner, Lexer::Cache* cache);
+
+		std::vector<Entry> m_entries;
+		const Lexer::Interner* m_interner;
+		const Lexer::Cache* m_cache;
+	};
+}
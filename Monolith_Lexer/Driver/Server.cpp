@@ -0,0 +1,418 @@
+#include "../Driver/Server.hpp"
+#include "../Lexer/Generator.hpp"
+#include "../Lexer/TokenStream.hpp"
+#include "../Lexer/JsonWriter.hpp"
+#include "../Helper/ThreadPool.hpp"
+#include "../Helper/Arena.hpp"
+#include "../Helper/SourceFile.hpp"
+#include <algorithm>
+#include <sstream>
+#include <chrono>
+#include <cmath>
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <format>
+
+#if not defined(_WIN32)
+#include <cerrno>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/time.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <memory>
+#endif
+
+Driver::Server::Server(const std::filesystem::path& socketPath, std::size_t threadCount, Lexer::Interner* interner, Lexer::Cache* cache)
+    : m_socketPath(socketPath), m_threadCount(threadCount), m_interner(interner), m_cache(cache), m_listener(-1), m_isStopping(false), m_wakeUp{ -1, -1 }
+{
+}
+Driver::Server::~Server(void)
+{
+    if (this->m_listener >= 0)
+    {
+        std::error_code error;
+        std::filesystem::remove(this->m_socketPath, error);
+    }
+}
+
+bool Driver::Server::run(void)
+{
+#if defined(_WIN32)
+    this->m_error = "Unix domain sockets are not supported on this platform";
+    return false;
+#else
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    std::string path = this->m_socketPath.string();
+    if (path.empty() or path.size() >= sizeof(address.sun_path))
+    {
+        this->m_error = std::format("Socket path is empty or too long: '{}'", path);
+        return false;
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    int listener = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listener < 0)
+    {
+        this->m_error = std::format("Could not make a socket: {}", std::strerror(errno));
+        return false;
+    }
+
+    // A socket file left by a server that didn't stop cleanly would make bind() fail.
+    std::error_code error;
+    std::filesystem::remove(this->m_socketPath, error);
+    if (::bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 or ::listen(listener, SOMAXCONN) != 0)
+    {
+        this->m_error = std::format("Could not listen on '{}': {}", path, std::strerror(errno));
+        ::close(listener);
+        return false;
+    }
+    if (::pipe2(this->m_wakeUp, O_CLOEXEC | O_NONBLOCK) != 0)
+    {
+        this->m_error = std::format("Could not make a pipe: {}", std::strerror(errno));
+        ::close(listener);
+        return false;
+    }
+    this->m_listener = listener;
+
+    // The idle connections. A connection that has a request is given to a thread and comes back through m_returned.
+    std::vector<std::unique_ptr<Driver::Server::Connection>> idle;
+    std::vector<pollfd> polled;
+    {
+        Helper::ThreadPool pool(this->m_threadCount);
+        while (not this->m_isStopping)
+        {
+            polled.clear();
+            polled.push_back({ listener, POLLIN, 0 });
+            polled.push_back({ this->m_wakeUp[0], POLLIN, 0 });
+            for (const auto& connection : idle)
+            {
+                polled.push_back({ connection->socket, POLLIN, 0 });
+            }
+            if (::poll(polled.data(), polled.size(), -1) < 0)
+            {
+                if (errno == EINTR) continue;
+                this->m_error = std::format("Could not poll: {}", std::strerror(errno));
+                break;
+            }
+
+            // Readable (Or closed, that is found by the first recv()), so a thread only waits for a client that stops in the middle of a request.
+            // From the back, so the indices of the ones that were not taken yet don't move.
+            for (std::size_t i = idle.size(); i-- > 0;)
+            {
+                if (not polled[i + 2].revents) continue;
+                Driver::Server::Connection* connection = idle[i].release();
+                idle.erase(idle.begin() + static_cast<std::ptrdiff_t>(i));
+                pool.submit([this, connection] { this->serve(connection); });
+            }
+
+            if (polled[1].revents)
+            {
+                char bytes[64];
+                while (::read(this->m_wakeUp[0], bytes, sizeof(bytes)) > 0)
+                {
+                }
+
+                std::lock_guard lock(this->m_returnedMutex);
+                for (auto [connection, isOpen] : this->m_returned)
+                {
+                    if (isOpen)
+                    {
+                        idle.emplace_back(connection);
+                        continue;
+                    }
+                    ::close(connection->socket);
+                    delete connection;
+                }
+                this->m_returned.clear();
+            }
+
+            if (polled[0].revents)
+            {
+                int client = ::accept4(listener, nullptr, nullptr, SOCK_CLOEXEC);
+                if (client < 0)
+                {
+                    if (errno == EINTR or errno == ECONNABORTED or errno == EAGAIN) continue;
+                    this->m_error = std::format("Could not accept: {}", std::strerror(errno));
+                    break;
+                }
+
+                // Only while a request is served. An idle connection waits in poll() and not in recv().
+                timeval timeout = { Driver::Server::receiveTimeout, 0 };
+                ::setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+                ::setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+                idle.emplace_back(std::make_unique<Driver::Server::Connection>(Driver::Server::Connection{ client, {}, 0, 0 }));
+            }
+        }
+    } // Waits for the requests that already started.
+
+    // The connections that came back after the loop stopped.
+    for (auto [connection, isOpen] : this->m_returned)
+    {
+        ::close(connection->socket);
+        delete connection;
+    }
+    this->m_returned.clear();
+    for (const auto& connection : idle)
+    {
+        ::close(connection->socket);
+    }
+
+    ::close(this->m_wakeUp[0]);
+    ::close(this->m_wakeUp[1]);
+    ::close(listener);
+    return this->m_error.empty();
+#endif
+}
+
+void Driver::Server::stop(void)
+{
+    this->m_isStopping = true;
+    this->wakeUp();
+}
+
+void Driver::Server::wakeUp(void)
+{
+#if not defined(_WIN32)
+    // Only a byte. If the pipe is full run() is going to wake up anyway.
+    if (this->m_wakeUp[1] >= 0)
+    {
+        char byte = 0;
+        [[maybe_unused]] auto count = ::write(this->m_wakeUp[1], &byte, 1);
+    }
+#endif
+}
+
+const std::string& Driver::Server::error(void) const
+{
+    return this->m_error;
+}
+
+void Driver::Server::serve(Driver::Server::Connection* connection)
+{
+    // Requests that were sent together are all served now, the poll() of run() only sees what was not received yet.
+    Driver::Server::Status status = this->handle(*connection);
+    while (status == Driver::Server::Status::OK and Driver::Server::hasLine(*connection))
+    {
+        status = this->handle(*connection);
+    }
+
+    {
+        std::lock_guard lock(this->m_returnedMutex);
+        this->m_returned.emplace_back(connection, status == Driver::Server::Status::OK and not this->m_isStopping);
+    }
+    this->wakeUp();
+}
+
+Driver::Server::Status Driver::Server::handle(Driver::Server::Connection& connection)
+{
+    std::optional<std::string> line = Driver::Server::readLine(connection);
+    if (not line)
+    {
+        return Driver::Server::Status::CLOSED;
+    }
+
+    // From the whole request line being there to the whole response being sent.
+    auto start = std::chrono::steady_clock::now();
+    auto fail = [&](const std::string& message) -> Driver::Server::Status
+    {
+        Driver::Server::send(connection.socket, std::format("ERROR {}\n", message));
+        this->record(static_cast<std::uint64_t>(std::chrono::nanoseconds(std::chrono::steady_clock::now() - start).count()), true);
+        return Driver::Server::Status::ERROR;
+    };
+
+    std::string_view request = line.value();
+    if (request == "STATS")
+    {
+        std::string payload = this->stats();
+        bool isSent = Driver::Server::send(connection.socket, std::format("OK {} 0\n", payload.size())) and Driver::Server::send(connection.socket, payload);
+        return isSent ? Driver::Server::Status::OK : Driver::Server::Status::CLOSED;
+    }
+    if (request == "SHUTDOWN")
+    {
+        Driver::Server::send(connection.socket, "OK 0 0\n");
+        this->stop();
+        return Driver::Server::Status::CLOSED;
+    }
+
+    // LEX <format> [decode] <PATH path|DATA size>.
+    auto nextWord = [&request](void) -> std::string_view
+    {
+        std::string_view word = request.substr(0, request.find(' '));
+        request.remove_prefix(std::min(word.size() + 1, request.size()));
+        return word;
+    };
+    if (nextWord() != "LEX") return fail("Unknown request");
+    std::string_view format = nextWord();
+    if (format != "lex" and format != "binary" and format != "json") return fail("Unknown format");
+    std::string_view source = nextWord();
+    bool shouldDecodeLiterals = source == "decode";
+    if (shouldDecodeLiterals) source = nextWord();
+
+    // The arena of this thread, the Generator of the last request is gone (See Helper::Arena).
+    thread_local Helper::Arena arena;
+    arena.reset();
+
+    std::string path;
+    std::optional<Lexer::Generator> generator;
+    if (source == "PATH")
+    {
+        if (request.empty()) return fail("No path");
+        path = request; // A path can have spaces, it's the rest of the line.
+        generator.emplace(path.c_str(), 1, this->m_interner, this->m_cache, shouldDecodeLiterals, &arena);
+    }
+    else if (source == "DATA")
+    {
+        std::uint64_t size = 0;
+        auto [end, error] = std::from_chars(request.data(), request.data() + request.size(), size);
+        if (error != std::errc() or end != request.data() + request.size()) return fail("Bad size");
+        if (size > std::numeric_limits<std::uint32_t>::max()) return fail("Source is too big. 4 GiB at most");
+
+        std::vector<char> bytes;
+        if (not Driver::Server::read(connection, static_cast<std::size_t>(size), bytes)) return Driver::Server::Status::CLOSED;
+        generator.emplace(Helper::SourceFile(std::move(bytes)), "<request>", 1, this->m_interner, this->m_cache, shouldDecodeLiterals, &arena);
+    }
+    else
+    {
+        return fail("Expected PATH or DATA");
+    }
+
+    // Written like Project writes its output file (See main.cpp).
+    std::ostringstream output;
+    if (format == "binary") Lexer::TokenStream::write(output, generator.value());
+    else if (format == "json") Lexer::JsonWriter(output).write(generator.value());
+    else output << generator.value();
+
+    std::string_view payload = output.view();
+    bool isSent = Driver::Server::send(connection.socket, std::format("OK {} {}\n", payload.size(), generator->errors().size()))
+        and Driver::Server::send(connection.socket, payload);
+    this->record(static_cast<std::uint64_t>(std::chrono::nanoseconds(std::chrono::steady_clock::now() - start).count()), false);
+    return isSent ? Driver::Server::Status::OK : Driver::Server::Status::CLOSED;
+}
+
+std::string Driver::Server::stats(void)
+{
+    std::vector<std::uint64_t> sorted;
+    std::uint64_t requestCount;
+    std::uint64_t errorCount;
+    {
+        std::lock_guard lock(this->m_latencies.mutex);
+        sorted = this->m_latencies.nanoseconds;
+        requestCount = this->m_latencies.requestCount;
+        errorCount = this->m_latencies.errorCount;
+    }
+    std::sort(sorted.begin(), sorted.end());
+
+    std::string text = std::format("Requests: {}\nErrors: {}\n", requestCount, errorCount);
+    if (sorted.empty())
+    {
+        return text;
+    }
+
+    // Nearest rank: the smallest value that at least percent of them are not bigger than. In microseconds.
+    auto percentile = [&sorted](double percent) -> double
+    {
+        std::size_t rank = static_cast<std::size_t>(std::ceil(percent / 100 * static_cast<double>(sorted.size())));
+        return static_cast<double>(sorted[std::clamp<std::size_t>(rank, 1, sorted.size()) - 1]) / 1000;
+    };
+    text += std::format("Latency of the last {} requests (us):\n", sorted.size());
+    text += std::format("{:>10}{:>10}{:>10}{:>10}{:>10}\n", "p50", "p90", "p99", "p99.9", "max");
+    text += std::format("{:>10.1f}{:>10.1f}{:>10.1f}{:>10.1f}{:>10.1f}\n", percentile(50), percentile(90), percentile(99), percentile(99.9), percentile(100));
+    return text;
+}
+
+void Driver::Server::record(std::uint64_t nanoseconds, bool isError)
+{
+    std::lock_guard lock(this->m_latencies.mutex);
+    if (this->m_latencies.nanoseconds.size() < Driver::Server::latenciesCount) this->m_latencies.nanoseconds.emplace_back(nanoseconds);
+    else this->m_latencies.nanoseconds[this->m_latencies.next] = nanoseconds;
+    this->m_latencies.next = (this->m_latencies.next + 1) % Driver::Server::latenciesCount;
+    this->m_latencies.requestCount++;
+    if (isError) this->m_latencies.errorCount++;
+}
+
+std::optional<std::string> Driver::Server::readLine(Driver::Server::Connection& connection)
+{
+    constexpr std::size_t MAX_LINE_SIZE = 1 << 16;
+    constexpr std::size_t BLOCK_SIZE = 1 << 16;
+    std::size_t searched = connection.begin;
+    while (true)
+    {
+        auto first = connection.buffer.begin();
+        auto newLine = std::find(first + static_cast<std::ptrdiff_t>(searched), first + static_cast<std::ptrdiff_t>(connection.end), '\n');
+        if (newLine != first + static_cast<std::ptrdiff_t>(connection.end))
+        {
+            std::string line(first + static_cast<std::ptrdiff_t>(connection.begin), newLine);
+            connection.begin = static_cast<std::size_t>(newLine - first) + 1;
+            return line;
+        }
+        if (connection.end - connection.begin > MAX_LINE_SIZE) return std::nullopt; // Not a request.
+        searched = connection.end;
+
+        // Move what is left to the front, then receive after it.
+        std::copy(first + static_cast<std::ptrdiff_t>(connection.begin), first + static_cast<std::ptrdiff_t>(connection.end), first);
+        searched -= connection.begin;
+        connection.end -= connection.begin;
+        connection.begin = 0;
+        if (connection.buffer.size() - connection.end < BLOCK_SIZE) connection.buffer.resize(connection.end + BLOCK_SIZE);
+
+#if defined(_WIN32)
+        return std::nullopt;
+#else
+        ssize_t count = ::recv(connection.socket, connection.buffer.data() + connection.end, connection.buffer.size() - connection.end, 0);
+        if (count < 0 and errno == EINTR) continue;
+        if (count <= 0) return std::nullopt;
+        connection.end += static_cast<std::size_t>(count);
+#endif
+    }
+}
+
+bool Driver::Server::read(Driver::Server::Connection& connection, std::size_t size, std::vector<char>& bytes)
+{
+    // What came with the request line first, then the rest straight into bytes.
+    bytes.resize(size);
+    std::size_t buffered = std::min(size, connection.end - connection.begin);
+    std::copy_n(connection.buffer.begin() + static_cast<std::ptrdiff_t>(connection.begin), buffered, bytes.begin());
+    connection.begin += buffered;
+
+    std::size_t done = buffered;
+    while (done < size)
+    {
+#if defined(_WIN32)
+        return false;
+#else
+        ssize_t count = ::recv(connection.socket, bytes.data() + done, size - done, 0);
+        if (count < 0 and errno == EINTR) continue;
+        if (count <= 0) return false;
+        done += static_cast<std::size_t>(count);
+#endif
+    }
+    return true;
+}
+
+bool Driver::Server::hasLine(const Driver::Server::Connection& connection)
+{
+    auto first = connection.buffer.begin();
+    return std::find(first + static_cast<std::ptrdiff_t>(connection.begin), first + static_cast<std::ptrdiff_t>(connection.end), '\n') != first + static_cast<std::ptrdiff_t>(connection.end);
+}
+
+bool Driver::Server::send(int socket, const std::string_view& bytes)
+{
+    std::size_t done = 0;
+    while (done < bytes.size())
+    {
+#if defined(_WIN32)
+        (void)socket;
+        return false;
+#else
+        ssize_t count = ::send(socket, bytes.data() + done, bytes.size() - done, MSG_NOSIGNAL); // No SIGPIPE when the client is gone.
+        if (count < 0 and errno == EINTR) continue;
+        if (count <= 0) return false;
+        done += static_cast<std::size_t>(count);
+#endif
+    }
+    return true;
+}
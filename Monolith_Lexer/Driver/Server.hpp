@@ -0,0 +1,96 @@
+#pragma once
+#include "../Lexer/Interner.hpp"
+#include "../Lexer/Cache.hpp"
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <filesystem>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <optional>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+namespace Driver
+{
+	// Lexes on request over a Unix domain socket, so many small files don't pay for starting a process each.
+	// A connection can send any number of requests, one after another. Idle connections wait in one poll() loop, and a connection
+	// only takes a thread of the pool (See Helper::ThreadPool) while it has a request, so idle clients never keep others waiting.
+	// A client that stops in the middle of a request (Or doesn't read its response) for receiveTimeout is dropped.
+	// Every thread keeps its arena between requests (See Helper::Arena), and all of them share the interner and the cache.
+	//
+	// A request is one line, and a response is one line that may be followed by a payload:
+	//   LEX <lex|binary|json> [decode] PATH <path>\n            -> OK <payload size> <error count>\n<payload>
+	//   LEX <lex|binary|json> [decode] DATA <size>\n<source>    -> Same, the source is sent instead of read from a file.
+	//   STATS\n                                                  -> OK <payload size> 0\n<payload> (Requests, errors and latency percentiles, as text).
+	//   SHUTDOWN\n                                               -> OK 0 0\n, and the server stops.
+	//   Anything else                                            -> ERROR <message>\n, and the connection is closed.
+	// The payload is what Project writes to its output file in that format, with the errors of the source in it (See main.cpp).
+	class Server
+	{
+	public:
+		Server(const std::filesystem::path& socketPath, std::size_t threadCount = std::thread::hardware_concurrency(),
+			Lexer::Interner* interner = nullptr, Lexer::Cache* cache = nullptr);
+		Server(const Driver::Server&) = delete;
+		Driver::Server& operator = (const Driver::Server&) = delete;
+		~Server(void); // Removes the socket file.
+
+		bool run(void); // Until SHUTDOWN or stop(). false if the socket could not be made, see error().
+		void stop(void); // From any thread. Requests that already started are finished first.
+
+		const std::string& error(void) const;
+
+	private:
+		enum class Status { OK, ERROR, CLOSED };
+
+		// Received bytes that are not used yet are [begin, end) of buffer. A request line can come in pieces, or many in one piece.
+		struct Connection
+		{
+			int socket;
+			std::vector<char> buffer;
+			std::size_t begin = 0;
+			std::size_t end = 0;
+		};
+
+		// Latencies of the last requests in a ring, so the memory doesn't grow with the uptime.
+		struct Latencies
+		{
+			std::mutex mutex;
+			std::vector<std::uint64_t> nanoseconds;
+			std::size_t next = 0;
+			std::uint64_t requestCount = 0;
+			std::uint64_t errorCount = 0;
+		};
+
+		void serve(Driver::Server::Connection* connection); // The requests it has, then gives it back to run().
+		void wakeUp(void);
+		Driver::Server::Status handle(Driver::Server::Connection& connection);
+		std::string stats(void);
+		void record(std::uint64_t nanoseconds, bool isError);
+
+		static std::optional<std::string> readLine(Driver::Server::Connection& connection); // Without the '\n'. std::nullopt on end of stream.
+		static bool read(Driver::Server::Connection& connection, std::size_t size, std::vector<char>& bytes);
+		static bool send(int socket, const std::string_view& bytes);
+		static bool hasLine(const Driver::Server::Connection& connection); // A whole request line was already received.
+
+		static constexpr std::size_t latenciesCount = 1 << 16;
+		static constexpr int receiveTimeout = 10; // Seconds.
+
+		std::filesystem::path m_socketPath;
+		std::size_t m_threadCount;
+		Lexer::Interner* m_interner;
+		Lexer::Cache* m_cache;
+		int m_listener;
+		std::atomic<bool> m_isStopping;
+		std::string m_error;
+
+		int m_wakeUp[2]; // A pipe. A byte written to it wakes up the poll() of run() (See stop() and serve()).
+		std::mutex m_returnedMutex;
+		std::vector<std::pair<Driver::Server::Connection*, bool>> m_returned; // Connections that serve() is done with, and if they are still open.
+
+		Driver::Server::Latencies m_latencies;
+	};
+}
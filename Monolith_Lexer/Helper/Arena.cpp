@@ -0,0 +1,65 @@
+#include "../Helper/Arena.hpp"
+#include <algorithm>
+#include <numeric>
+
+Helper::Arena::Arena(std::size_t blockSize) : m_used(0), m_blockSize(blockSize)
+{
+}
+
+void Helper::Arena::reset(void)
+{
+    // One block of everything that was needed, so the next round (Of about the same size) fits in it.
+    if (this->m_blocks.size() > 1)
+    {
+        std::size_t size = this->capacity();
+        this->m_blocks.clear();
+        this->m_blocks.emplace_back(std::make_unique_for_overwrite<std::byte[]>(size), size);
+        this->m_blockSize = std::max(this->m_blockSize, size);
+    }
+    this->m_used = 0;
+}
+
+std::size_t Helper::Arena::capacity(void) const
+{
+    return std::accumulate(this->m_blocks.begin(), this->m_blocks.end(), std::size_t(0), [](std::size_t sum, const Block& block) -> std::size_t
+    {
+        return sum + block.size;
+    });
+}
+
+void* Helper::Arena::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    if (not this->m_blocks.empty())
+    {
+        Block& block = this->m_blocks.back();
+        void* pointer = block.data.get() + this->m_used;
+        std::size_t space = block.size - this->m_used;
+        if (std::align(alignment, bytes, pointer, space))
+        {
+            this->m_used = block.size - space + bytes;
+            return pointer;
+        }
+    }
+
+    // A new block, twice as big as the last one (A vector that grows doubles too). The rest of the last block is lost.
+    std::size_t size = std::max(this->m_blockSize, bytes + alignment);
+    this->m_blocks.emplace_back(std::make_unique_for_overwrite<std::byte[]>(size), size);
+    this->m_blockSize = size * 2;
+
+    void* pointer = this->m_blocks.back().data.get();
+    std::size_t space = size;
+    std::align(alignment, bytes, pointer, space); // Always fits.
+    this->m_used = size - space + bytes;
+    return pointer;
+}
+void Helper::Arena::do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment)
+{
+    // Freed all at once by reset().
+    (void)pointer;
+    (void)bytes;
+    (void)alignment;
+}
+bool Helper::Arena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
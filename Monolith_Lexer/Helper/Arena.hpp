@@ -0,0 +1,39 @@
+#pragma once
+#include <memory_resource>
+#include <memory>
+#include <vector>
+#include <cstddef>
+
+namespace Helper
+{
+	// A monotonic memory resource that is reused: allocations only bump a pointer, deallocations do nothing,
+	// and reset() frees everything at once but keeps the memory for the next round (See Driver::Batch).
+	// If a round needed more than one block, reset() swaps them for one block of their total size, so after a few rounds
+	// every round is served from a single block and never calls malloc. Not thread safe, use one per thread.
+	class Arena : public std::pmr::memory_resource
+	{
+	public:
+		Arena(std::size_t blockSize = 1 << 20);
+		Arena(const Helper::Arena&) = delete;
+		Helper::Arena& operator = (const Helper::Arena&) = delete;
+
+		void reset(void); // Everything that was allocated is invalid after it.
+
+		std::size_t capacity(void) const; // Bytes in all the blocks.
+
+	private:
+		struct Block
+		{
+			std::unique_ptr<std::byte[]> data;
+			std::size_t size;
+		};
+
+		void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+		void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override;
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+		std::vector<Block> m_blocks; // The last one is the one in use.
+		std::size_t m_used; // Bytes of the last block.
+		std::size_t m_blockSize; // Of the next new block.
+	};
+}
@@ -1,8 +0,0 @@
-#pragma once
-#include <string>
-#include <optional>
-
-namespace Helper
-{
-	std::optional<std::string> extractFileContent(const char* filename);
-}
\ No newline at end of file
@@ -0,0 +1,33 @@
+#include "../Helper/OutputBuffer.hpp"
+#include <cstring>
+
+Helper::OutputBuffer::OutputBuffer(std::ostream& stream, std::size_t size) : m_stream(stream), m_buffer(size), m_size(0)
+{
+}
+Helper::OutputBuffer::~OutputBuffer(void)
+{
+    this->flush();
+}
+
+void Helper::OutputBuffer::write(const std::string_view& text)
+{
+    if (text.size() > this->m_buffer.size())
+    {
+        this->flush();
+        this->m_stream.write(text.data(), static_cast<std::streamsize>(text.size()));
+        return;
+    }
+    std::memcpy(this->reserve(text.size()), text.data(), text.size());
+    this->m_size += text.size();
+}
+void Helper::OutputBuffer::flush(void)
+{
+    if (not this->m_size) return;
+    this->m_stream.write(this->m_buffer.data(), static_cast<std::streamsize>(this->m_size));
+    this->m_size = 0;
+}
+
+std::ostream& Helper::OutputBuffer::stream(void) const
+{
+    return this->m_stream;
+}
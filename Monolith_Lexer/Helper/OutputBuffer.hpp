@@ -0,0 +1,54 @@
+#pragma once
+#include <vector>
+#include <string_view>
+#include <ostream>
+#include <cstddef>
+
+namespace Helper
+{
+	// A reusable byte buffer in front of a std::ostream, for writers that make a lot of small pieces (See Lexer::Writer).
+	// Pieces are put into the buffer with memcpy, and the buffer is given to the stream with one write() when it's full
+	// (Big writes skip the buffer of std::filebuf, so that is one system call). Text bigger than the buffer is written straight through.
+	class OutputBuffer
+	{
+	public:
+		OutputBuffer(std::ostream& stream, std::size_t size = 1 << 20);
+		OutputBuffer(const Helper::OutputBuffer&) = delete;
+		Helper::OutputBuffer& operator = (const Helper::OutputBuffer&) = delete;
+		~OutputBuffer(void); // Flushes.
+
+		// Room for size more bytes, then commit() how many were used. Only for small pieces, the buffer grows to size if needed.
+		char* reserve(std::size_t size);
+		void commit(std::size_t size);
+
+		void write(const std::string_view& text);
+		void write(char c);
+		void flush(void);
+
+		std::ostream& stream(void) const;
+
+	private:
+		std::ostream& m_stream;
+		std::vector<char> m_buffer;
+		std::size_t m_size; // Used bytes of m_buffer.
+	};
+
+	inline char* Helper::OutputBuffer::reserve(std::size_t size)
+	{
+		if (this->m_buffer.size() - this->m_size < size)
+		{
+			this->flush();
+			if (this->m_buffer.size() < size) this->m_buffer.resize(size);
+		}
+		return this->m_buffer.data() + this->m_size;
+	}
+	inline void Helper::OutputBuffer::commit(std::size_t size)
+	{
+		this->m_size += size;
+	}
+	inline void Helper::OutputBuffer::write(char c)
+	{
+		*this->reserve(1) = c;
+		this->m_size++;
+	}
+}
@@ -0,0 +1,227 @@
+#include "../Helper/Simd.hpp"
+#include <array>
+#include <bit>
+#include <cstdint>
+
+#if not defined(MONOLITH_FORCE_SCALAR) and (defined(__x86_64__) or defined(_M_X64))
+#define MONOLITH_SIMD_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define MONOLITH_TARGET_AVX2
+#else
+#define MONOLITH_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace
+{
+    // Scalar.
+    enum CharBits : std::uint8_t
+    {
+        NEW_LINE = 1 << 0,
+        BLANK = 1 << 1,
+        DIGIT = 1 << 2,
+        WORD = 1 << 3, // Letters, digits and '_'.
+        JSON_ESCAPE = 1 << 4, // '"', '\\' and below ' '.
+    };
+
+    constexpr std::array<std::uint8_t, 256> makeCharBits(void)
+    {
+        std::array<std::uint8_t, 256> bits{};
+        for (unsigned char c = 'a'; c <= 'z'; c++) bits[c] |= WORD;
+        for (unsigned char c = 'A'; c <= 'Z'; c++) bits[c] |= WORD;
+        for (unsigned char c = '0'; c <= '9'; c++) bits[c] |= WORD | DIGIT;
+        bits['_'] |= WORD;
+        bits[' '] |= BLANK;
+        bits['\t'] |= BLANK;
+        bits['\n'] |= NEW_LINE;
+        for (unsigned char c = 0; c < ' '; c++) bits[c] |= JSON_ESCAPE;
+        bits['"'] |= JSON_ESCAPE;
+        bits['\\'] |= JSON_ESCAPE;
+        return bits;
+    }
+    constexpr std::array<std::uint8_t, 256> charBits = makeCharBits();
+
+    // Returns the index of the first char that is (Until = true) or is not (Until = false) in Bits.
+    template <std::uint8_t Bits, bool Until>
+    std::size_t scanScalar(const std::string_view& view)
+    {
+        std::size_t i = 0;
+        for (i = 0; i < view.size(); i++)
+        {
+            bool inClass = charBits[static_cast<unsigned char>(view[i])] & Bits;
+            if (inClass == Until) break;
+        }
+        return i;
+    }
+
+#if defined(MONOLITH_SIMD_X86)
+    // SSE2 (Always there on x86-64).
+    __m128i newLineMask128(__m128i chunk)
+    {
+        return _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\n'));
+    }
+    __m128i blankMask128(__m128i chunk)
+    {
+        return _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\t')));
+    }
+    __m128i digitMask128(__m128i chunk)
+    {
+        // Signed compares. Bytes above 127 are negative so they never land in a range.
+        return _mm_and_si128(_mm_cmpgt_epi8(chunk, _mm_set1_epi8('0' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), chunk));
+    }
+    __m128i wordMask128(__m128i chunk)
+    {
+        __m128i lower = _mm_or_si128(chunk, _mm_set1_epi8(0x20)); // 'A'-'Z' to 'a'-'z'. Nothing else lands in 'a'-'z'.
+        __m128i letter = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('z' + 1), lower));
+        __m128i underscore = _mm_cmpeq_epi8(chunk, _mm_set1_epi8('_'));
+        return _mm_or_si128(_mm_or_si128(letter, underscore), digitMask128(chunk));
+    }
+    __m128i jsonEscapeMask128(__m128i chunk)
+    {
+        __m128i control = _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(' '), chunk), _mm_cmpgt_epi8(chunk, _mm_set1_epi8(-1)));
+        __m128i quote = _mm_cmpeq_epi8(chunk, _mm_set1_epi8('"'));
+        __m128i backslash = _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\\'));
+        return _mm_or_si128(control, _mm_or_si128(quote, backslash));
+    }
+
+    template <__m128i(*Mask)(__m128i), std::uint8_t Bits, bool Until>
+    std::size_t scanSse2(const std::string_view& view)
+    {
+        std::size_t i = 0;
+        for (i = 0; i + sizeof(__m128i) <= view.size(); i += sizeof(__m128i))
+        {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(view.data() + i));
+            std::uint32_t hits = static_cast<std::uint32_t>(_mm_movemask_epi8(Mask(chunk)));
+            if (not Until) hits = ~hits & 0xFFFF;
+            if (hits) return i + std::countr_zero(hits);
+        }
+        return i + scanScalar<Bits, Until>(view.substr(i)); // Tail.
+    }
+
+    // AVX2.
+    MONOLITH_TARGET_AVX2 __m256i newLineMask256(__m256i chunk)
+    {
+        return _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\n'));
+    }
+    MONOLITH_TARGET_AVX2 __m256i blankMask256(__m256i chunk)
+    {
+        return _mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\t')));
+    }
+    MONOLITH_TARGET_AVX2 __m256i digitMask256(__m256i chunk)
+    {
+        return _mm256_and_si256(_mm256_cmpgt_epi8(chunk, _mm256_set1_epi8('0' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), chunk));
+    }
+    MONOLITH_TARGET_AVX2 __m256i wordMask256(__m256i chunk)
+    {
+        __m256i lower = _mm256_or_si256(chunk, _mm256_set1_epi8(0x20));
+        __m256i letter = _mm256_and_si256(_mm256_cmpgt_epi8(lower, _mm256_set1_epi8('a' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), lower));
+        __m256i underscore = _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('_'));
+        return _mm256_or_si256(_mm256_or_si256(letter, underscore), digitMask256(chunk));
+    }
+    MONOLITH_TARGET_AVX2 __m256i jsonEscapeMask256(__m256i chunk)
+    {
+        __m256i control = _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(' '), chunk), _mm256_cmpgt_epi8(chunk, _mm256_set1_epi8(-1)));
+        __m256i quote = _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('"'));
+        __m256i backslash = _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\\'));
+        return _mm256_or_si256(control, _mm256_or_si256(quote, backslash));
+    }
+
+    template <__m256i(*Mask)(__m256i), __m128i(*Mask128)(__m128i), std::uint8_t Bits, bool Until>
+    MONOLITH_TARGET_AVX2 std::size_t scanAvx2(const std::string_view& view)
+    {
+        std::size_t i = 0;
+        for (i = 0; i + sizeof(__m256i) <= view.size(); i += sizeof(__m256i))
+        {
+            __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(view.data() + i));
+            std::uint32_t hits = static_cast<std::uint32_t>(_mm256_movemask_epi8(Mask(chunk)));
+            if (not Until) hits = ~hits;
+            if (hits) return i + std::countr_zero(hits);
+        }
+        return i + scanSse2<Mask128, Bits, Until>(view.substr(i)); // Tail.
+    }
+
+    bool hasAvx2(void)
+    {
+    #if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7) return false;
+        __cpuid(info, 1);
+        bool osSavesYmm = (info[2] & (1 << 27)) and ((_xgetbv(0) & 0x6) == 0x6); // OSXSAVE and the OS saves the YMM registers.
+        __cpuidex(info, 7, 0);
+        return osSavesYmm and (info[1] & (1 << 5));
+    #else
+        __builtin_cpu_init(); // We can run before main (Static initialization).
+        return __builtin_cpu_supports("avx2");
+    #endif
+    }
+#endif
+
+    struct Kernels
+    {
+        const char* name;
+        std::size_t (*findNewLine)(const std::string_view&);
+        std::size_t (*countBlanks)(const std::string_view&);
+        std::size_t (*countWordChars)(const std::string_view&);
+        std::size_t (*countDigits)(const std::string_view&);
+        std::size_t (*findJsonEscape)(const std::string_view&);
+    };
+
+    Kernels pickKernels(void)
+    {
+    #if defined(MONOLITH_SIMD_X86)
+        if (hasAvx2())
+        {
+            return Kernels{ "AVX2",
+                scanAvx2<newLineMask256, newLineMask128, NEW_LINE, true>,
+                scanAvx2<blankMask256, blankMask128, BLANK, false>,
+                scanAvx2<wordMask256, wordMask128, WORD, false>,
+                scanAvx2<digitMask256, digitMask128, DIGIT, false>,
+                scanAvx2<jsonEscapeMask256, jsonEscapeMask128, JSON_ESCAPE, true> };
+        }
+        return Kernels{ "SSE2",
+            scanSse2<newLineMask128, NEW_LINE, true>,
+            scanSse2<blankMask128, BLANK, false>,
+            scanSse2<wordMask128, WORD, false>,
+            scanSse2<digitMask128, DIGIT, false>,
+            scanSse2<jsonEscapeMask128, JSON_ESCAPE, true> };
+    #else
+        return Kernels{ "Scalar",
+            scanScalar<NEW_LINE, true>,
+            scanScalar<BLANK, false>,
+            scanScalar<WORD, false>,
+            scanScalar<DIGIT, false>,
+            scanScalar<JSON_ESCAPE, true> };
+    #endif
+    }
+
+    const Kernels kernels = pickKernels();
+}
+
+std::size_t Helper::Simd::findNewLine(const std::string_view& view)
+{
+    return kernels.findNewLine(view);
+}
+std::size_t Helper::Simd::countBlanks(const std::string_view& view)
+{
+    return kernels.countBlanks(view);
+}
+std::size_t Helper::Simd::countWordChars(const std::string_view& view)
+{
+    return kernels.countWordChars(view);
+}
+std::size_t Helper::Simd::countDigits(const std::string_view& view)
+{
+    return kernels.countDigits(view);
+}
+std::size_t Helper::Simd::findJsonEscape(const std::string_view& view)
+{
+    return kernels.findJsonEscape(view);
+}
+
+const char* Helper::Simd::name(void)
+{
+    return kernels.name;
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include <string_view>
+#include <cstddef>
+
+// Character scanning kernels for the lexer hot loops.
+// The fastest version the CPU supports (AVX2 -> SSE2 -> Scalar) is picked once at runtime.
+// Build with MONOLITH_FORCE_SCALAR (CMake option) to always use the scalar version, useful to compare results.
+// Note: Only ASCII is classified (Unlike std::isalnum it doesn't depend on the locale).
+
+namespace Helper::Simd
+{
+	std::size_t findNewLine(const std::string_view& view); // Index of the first '\n', or view.size() if there is none.
+	std::size_t countBlanks(const std::string_view& view); // Length of the ' ' and '\t' run at the start of view.
+	std::size_t countWordChars(const std::string_view& view); // Length of the [A-Za-z0-9_] run at the start of view.
+	std::size_t countDigits(const std::string_view& view); // Length of the [0-9] run at the start of view.
+	std::size_t findJsonEscape(const std::string_view& view); // Index of the first '"', '\\' or control char below ' ', or view.size() if there is none.
+
+	const char* name(void); // "AVX2", "SSE2" or "Scalar".
+}
@@ -0,0 +1,143 @@
+#include "../Helper/SourceFile.hpp"
+#include <utility>
+
+#if defined(_WIN32)
+#include <fstream>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+std::optional<Helper::SourceFile> Helper::SourceFile::open(const char* filename)
+{
+    Helper::SourceFile file;
+
+#if defined(_WIN32)
+    // Text mode like before, so "\r\n" still becomes "\n". A mapping would keep the "\r".
+    std::ifstream stream(filename, std::ios::in);
+    if (not stream)
+    {
+        return std::nullopt;
+    }
+
+    constexpr std::size_t BLOCK_SIZE = 1 << 16;
+    std::size_t size = 0;
+    do
+    {
+        file.m_buffer.resize(size + BLOCK_SIZE);
+        stream.read(file.m_buffer.data() + size, BLOCK_SIZE);
+        size += static_cast<std::size_t>(stream.gcount());
+    } while (stream);
+    file.m_buffer.resize(size);
+#else
+    int fd = ::open(filename, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return std::nullopt;
+    }
+
+    // Only regular files can be mapped. Empty ones are read too because of files like /proc/* that report a size of 0.
+    struct stat info;
+    bool isRegular = ::fstat(fd, &info) == 0 and S_ISREG(info.st_mode) and info.st_size > 0;
+    bool success = (isRegular and file.map(fd, static_cast<std::size_t>(info.st_size))) or file.read(fd);
+    ::close(fd); // The mapping doesn't need the fd.
+
+    if (not success)
+    {
+        return std::nullopt;
+    }
+#endif
+
+    return file;
+}
+
+Helper::SourceFile::SourceFile(std::vector<char>&& buffer) : m_buffer(std::move(buffer))
+{
+}
+Helper::SourceFile::SourceFile(Helper::SourceFile&& other) noexcept
+    : m_mapping(std::exchange(other.m_mapping, nullptr)), m_mappingSize(std::exchange(other.m_mappingSize, 0)), m_buffer(std::move(other.m_buffer))
+{
+}
+Helper::SourceFile& Helper::SourceFile::operator = (Helper::SourceFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        this->unmap();
+        this->m_mapping = std::exchange(other.m_mapping, nullptr);
+        this->m_mappingSize = std::exchange(other.m_mappingSize, 0);
+        this->m_buffer = std::move(other.m_buffer);
+    }
+    return *this;
+}
+Helper::SourceFile::~SourceFile(void)
+{
+    this->unmap();
+}
+
+std::string_view Helper::SourceFile::view(void) const
+{
+    if (this->isMapped())
+    {
+        return std::string_view(static_cast<const char*>(this->m_mapping), this->m_mappingSize);
+    }
+    return std::string_view(this->m_buffer.data(), this->m_buffer.size());
+}
+bool Helper::SourceFile::isMapped(void) const
+{
+    return this->m_mapping != nullptr;
+}
+
+bool Helper::SourceFile::map(int fd, std::size_t size)
+{
+#if defined(_WIN32)
+    return false;
+#else
+    void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED)
+    {
+        return false;
+    }
+    ::madvise(mapping, size, MADV_SEQUENTIAL); // The lexer reads it once from start to end.
+
+    this->m_mapping = mapping;
+    this->m_mappingSize = size;
+    return true;
+#endif
+}
+bool Helper::SourceFile::read(int fd)
+{
+#if defined(_WIN32)
+    return false;
+#else
+    constexpr std::size_t BLOCK_SIZE = 1 << 16;
+    std::size_t size = 0;
+    while (true)
+    {
+        this->m_buffer.resize(size + BLOCK_SIZE);
+        ssize_t count = ::read(fd, this->m_buffer.data() + size, BLOCK_SIZE);
+        if (count < 0 and errno == EINTR) continue;
+        if (count < 0)
+        {
+            return false;
+        }
+        if (count == 0) break;
+        size += static_cast<std::size_t>(count);
+    }
+    this->m_buffer.resize(size);
+    return true;
+#endif
+}
+void Helper::SourceFile::unmap(void)
+{
+#if not defined(_WIN32)
+    if (this->m_mapping)
+    {
+        ::munmap(this->m_mapping, this->m_mappingSize);
+    }
+#endif
+    this->m_mapping = nullptr;
+    this->m_mappingSize = 0;
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <vector>
+#include <string_view>
+#include <optional>
+#include <cstddef>
+
+namespace Helper
+{
+	// The content of a file without copying it around.
+	// Regular files are memory-mapped, so views point straight into the mapping.
+	// Anything that can't be mapped (Pipes, /dev/stdin and ect) is read into a buffer with big read() calls.
+	// Views stay valid as long as the SourceFile lives (Also after moving it).
+	class SourceFile
+	{
+	public:
+		static std::optional<Helper::SourceFile> open(const char* filename);
+
+		SourceFile(void) = default;
+		explicit SourceFile(std::vector<char>&& buffer); // A source that is not a file (See Driver::Server).
+		SourceFile(Helper::SourceFile&& other) noexcept;
+		Helper::SourceFile& operator = (Helper::SourceFile&& other) noexcept;
+		SourceFile(const Helper::SourceFile&) = delete;
+		Helper::SourceFile& operator = (const Helper::SourceFile&) = delete;
+		~SourceFile(void);
+
+		std::string_view view(void) const;
+		bool isMapped(void) const;
+
+	private:
+		bool map(int fd, std::size_t size);
+		bool read(int fd);
+		void unmap(void);
+
+		void* m_mapping = nullptr;
+		std::size_t m_mappingSize = 0;
+		std::vector<char> m_buffer; // Not std::string. Small strings live inside the object and would move with it.
+	};
+}
@@ -0,0 +1,106 @@
+#include "../Helper/ThreadPool.hpp"
+#include <algorithm>
+
+Helper::ThreadPool::ThreadPool(std::size_t threadCount)
+    : m_nextWorker(0), m_queuedCount(0), m_unfinishedCount(0), m_isStopping(false)
+{
+    threadCount = std::max<std::size_t>(threadCount, 1); // hardware_concurrency() can be 0.
+
+    for (std::size_t i = 0; i < threadCount; i++)
+    {
+        this->m_workers.emplace_back(std::make_unique<Worker>());
+    }
+    for (std::size_t i = 0; i < threadCount; i++)
+    {
+        this->m_threads.emplace_back(&Helper::ThreadPool::run, this, i);
+    }
+}
+Helper::ThreadPool::~ThreadPool(void)
+{
+    this->wait();
+    {
+        std::lock_guard lock(this->m_mutex);
+        this->m_isStopping = true;
+    }
+    this->m_wakeUp.notify_all();
+
+    for (std::thread& thread : this->m_threads)
+    {
+        thread.join();
+    }
+}
+
+void Helper::ThreadPool::submit(std::function<void(void)> task)
+{
+    {
+        // Counted first (And under m_mutex) so the counts never go below 0 and a worker that is about to sleep can't miss it.
+        std::lock_guard lock(this->m_mutex);
+        this->m_queuedCount++;
+        this->m_unfinishedCount++;
+    }
+    Worker& worker = *this->m_workers[this->m_nextWorker++ % this->m_workers.size()];
+    {
+        std::lock_guard lock(worker.mutex);
+        worker.tasks.emplace_back(std::move(task));
+    }
+    this->m_wakeUp.notify_one();
+}
+void Helper::ThreadPool::wait(void)
+{
+    std::unique_lock lock(this->m_mutex);
+    this->m_idle.wait(lock, [this] { return this->m_unfinishedCount == 0; });
+}
+
+std::size_t Helper::ThreadPool::size(void) const
+{
+    return this->m_threads.size();
+}
+
+void Helper::ThreadPool::run(std::size_t index)
+{
+    std::function<void(void)> task;
+    while (true)
+    {
+        if (this->tryPop(index, task))
+        {
+            task();
+            task = nullptr;
+
+            std::lock_guard lock(this->m_mutex);
+            if (--this->m_unfinishedCount == 0) this->m_idle.notify_all();
+            continue;
+        }
+
+        std::unique_lock lock(this->m_mutex);
+        this->m_wakeUp.wait(lock, [this] { return this->m_queuedCount > 0 or this->m_isStopping; });
+        if (this->m_queuedCount == 0 and this->m_isStopping) return;
+    }
+}
+bool Helper::ThreadPool::tryPop(std::size_t index, std::function<void(void)>& task)
+{
+    // Own queue first (From the front), then steal from the others (From the back).
+    for (std::size_t i = 0; i < this->m_workers.size(); i++)
+    {
+        bool isOwn = i == 0;
+        Worker& worker = *this->m_workers[(index + i) % this->m_workers.size()];
+
+        std::lock_guard lock(worker.mutex);
+        if (worker.tasks.empty()) continue;
+
+        if (isOwn)
+        {
+            task = std::move(worker.tasks.front());
+            worker.tasks.pop_front();
+        }
+        else
+        {
+            task = std::move(worker.tasks.back());
+            worker.tasks.pop_back();
+        }
+
+        std::lock_guard countLock(this->m_mutex);
+        this->m_queuedCount--;
+        return true;
+    }
+    return false;
+}
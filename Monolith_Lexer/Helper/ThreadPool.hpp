@@ -0,0 +1,52 @@
+#pragma once
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <atomic>
+#include <cstddef>
+
+namespace Helper
+{
+	// Work-stealing thread pool.
+	// Every worker has its own queue. Tasks are dealt to the queues in the order they are submitted,
+	// a worker takes from the front of its own queue, and when it's empty it steals from the back of the others.
+	// So submitting the biggest tasks first makes them start first.
+	class ThreadPool
+	{
+	public:
+		ThreadPool(std::size_t threadCount = std::thread::hardware_concurrency());
+		ThreadPool(const Helper::ThreadPool&) = delete;
+		Helper::ThreadPool& operator = (const Helper::ThreadPool&) = delete;
+		~ThreadPool(void); // Finishes every submitted task first.
+
+		void submit(std::function<void(void)> task);
+		void wait(void); // Until every submitted task is done.
+
+		std::size_t size(void) const;
+
+	private:
+		struct Worker
+		{
+			std::mutex mutex;
+			std::deque<std::function<void(void)>> tasks;
+		};
+
+		void run(std::size_t index);
+		bool tryPop(std::size_t index, std::function<void(void)>& task);
+
+		std::vector<std::unique_ptr<Worker>> m_workers;
+		std::vector<std::thread> m_threads;
+		std::atomic<std::size_t> m_nextWorker;
+
+		std::mutex m_mutex; // For the two condition variables below.
+		std::condition_variable m_wakeUp;
+		std::condition_variable m_idle;
+		std::size_t m_queuedCount; // Tasks in queues.
+		std::size_t m_unfinishedCount; // Tasks submitted and not finished yet.
+		bool m_isStopping;
+	};
+}
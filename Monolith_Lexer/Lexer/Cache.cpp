@@ -0,0 +1,158 @@
+#include "../Lexer/Cache.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <fstream>
+#include <format>
+#include <thread>
+#include <cstring>
+
+namespace
+{
+    constexpr std::string_view extension = ".lexcache";
+
+    // Both versions are in the name, so an entry of an old lexer is never found.
+    std::string versionSuffix(void)
+    {
+        return std::format(".v{}-{}{}", Lexer::Cache::lexerVersion, Lexer::TokenStream::version, extension);
+    }
+}
+
+Lexer::Cache::Cache(const std::filesystem::path& directory, std::uintmax_t maxSize) : m_directory(directory), m_maxSize(maxSize)
+{
+    std::error_code error;
+    std::filesystem::create_directories(this->m_directory, error);
+}
+
+std::optional<Lexer::TokenStream> Lexer::Cache::find(const std::string_view& source)
+{
+    std::filesystem::path path = this->pathOf(source);
+    std::optional<Lexer::TokenStream> stream = Lexer::TokenStream::open(path.string().c_str());
+    if (not stream or stream->source() != source) return std::nullopt;
+
+    std::error_code error;
+    std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), error); // Recently used.
+    return stream;
+}
+void Lexer::Cache::store(const std::string_view& source, const Lexer::TokenList& tokens, const std::vector<Lexer::Diagnostic>& errors)
+{
+    std::filesystem::path path = this->pathOf(source);
+    std::size_t unique = std::hash<std::thread::id>()(std::this_thread::get_id()) ^ static_cast<std::size_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+    std::filesystem::path temporary = path;
+    temporary += std::format(".{}.tmp", unique);
+
+    {
+        std::ofstream stream(temporary, std::ios::out | std::ios::trunc | std::ios::binary);
+        Lexer::TokenStream::write(stream, source, tokens, errors);
+        if (not stream.flush())
+        {
+            stream.close();
+            std::error_code error;
+            std::filesystem::remove(temporary, error);
+            return;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error);
+    if (error) std::filesystem::remove(temporary, error);
+}
+void Lexer::Cache::trim(void)
+{
+    struct Entry
+    {
+        std::filesystem::path path;
+        std::filesystem::file_time_type time;
+        std::uintmax_t size;
+    };
+    std::vector<Entry> entries;
+
+    std::string suffix = versionSuffix();
+    std::uintmax_t temporarySize = 0;
+    auto now = std::filesystem::file_time_type::clock::now();
+    std::error_code error;
+    for (const auto& file : std::filesystem::directory_iterator(this->m_directory, error))
+    {
+        std::string name = file.path().filename().string();
+
+        // Left by a store() that was interrupted. A recent one can still be written by another process, so it only counts.
+        std::error_code fileError;
+        if (name.ends_with(".tmp") and name.find(extension) != std::string::npos)
+        {
+            std::filesystem::file_time_type time = file.last_write_time(fileError);
+            if (fileError) continue;
+            if (now - time > Lexer::Cache::temporaryLifetime) std::filesystem::remove(file.path(), fileError);
+            else temporarySize += file.file_size(fileError);
+            continue;
+        }
+
+        if (not name.ends_with(extension)) continue;
+        if (not name.ends_with(suffix))
+        {
+            std::filesystem::remove(file.path(), fileError);
+            continue;
+        }
+        Entry entry{ file.path(), file.last_write_time(fileError), file.file_size(fileError) };
+        if (not fileError) entries.emplace_back(std::move(entry));
+    }
+
+    // Newest first. Keep what fits.
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) -> bool { return a.time > b.time; });
+    std::uintmax_t size = temporarySize;
+    for (const Entry& entry : entries)
+    {
+        size += entry.size;
+        if (size > this->m_maxSize) std::filesystem::remove(entry.path, error);
+    }
+}
+
+std::uint64_t Lexer::Cache::hash(const std::string_view& content)
+{
+    // Four independent lanes of 8 bytes like xxHash64, so the multiplications of a 32 byte block overlap.
+    // Not cryptographic. A collision is still caught by find().
+    constexpr std::uint64_t prime1 = 0x9E3779B185EBCA87;
+    constexpr std::uint64_t prime2 = 0xC2B2AE3D27D4EB4F;
+    auto mix = [](std::uint64_t lane, std::uint64_t word) -> std::uint64_t
+    {
+        return std::rotl(lane + word * prime2, 31) * prime1;
+    };
+
+    const char* data = content.data();
+    std::size_t size = content.size();
+    std::array<std::uint64_t, 4> lanes = { prime1 + prime2, prime2, 0, 0 - prime1 };
+    while (size >= 32)
+    {
+        for (std::uint64_t& lane : lanes)
+        {
+            std::uint64_t word;
+            std::memcpy(&word, data, 8);
+            lane = mix(lane, word);
+            data += 8;
+        }
+        size -= 32;
+    }
+
+    std::uint64_t hash = std::rotl(lanes[0], 1) + std::rotl(lanes[1], 7) + std::rotl(lanes[2], 12) + std::rotl(lanes[3], 18) + content.size();
+    while (size)
+    {
+        std::uint64_t word = 0;
+        std::size_t count = std::min<std::size_t>(size, 8);
+        std::memcpy(&word, data, count);
+        hash = std::rotl(hash ^ mix(0, word), 27) * prime1 + prime2;
+        data += count;
+        size -= count;
+    }
+
+    hash ^= hash >> 33;
+    hash *= prime2;
+    hash ^= hash >> 29;
+    hash *= prime1;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+std::filesystem::path Lexer::Cache::pathOf(const std::string_view& source) const
+{
+    return this->m_directory / std::format("{:016x}-{:x}{}", Lexer::Cache::hash(source), source.size(), versionSuffix());
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include "../Lexer/TokenStream.hpp"
+#include "../Lexer/TokenList.hpp"
+#include "../Lexer/Diagnostic.hpp"
+
+#include <vector>
+#include <string_view>
+#include <optional>
+#include <filesystem>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+namespace Lexer
+{
+	// A directory of lexed sources, so a source that didn't change since it was last lexed is not lexed again (See Lexer::Generator).
+	// An entry is the binary token stream of a source (See Lexer::TokenStream), named by the hash of the source content,
+	// its size, and the versions of the lexer and of the stream format. An entry of another version is never found and is removed by trim().
+	// A found entry is checked against the source itself (The stream keeps it), so a hash collision is a miss and not wrong tokens.
+	// Entries are written to a temporary file and renamed, so many processes (And threads) can share a directory.
+	// The size is only kept by trim(): it removes the least recently used entries (By modification time, a hit touches it).
+	class Cache
+	{
+	public:
+		// Bump it when the tokens or errors of any source change, every old entry is invalid then.
+		static constexpr std::uint32_t lexerVersion = 1;
+
+		Cache(const std::filesystem::path& directory, std::uintmax_t maxSize = std::uintmax_t(1) << 30); // Bytes.
+
+		std::optional<Lexer::TokenStream> find(const std::string_view& source);
+		void store(const std::string_view& source, const Lexer::TokenList& tokens, const std::vector<Lexer::Diagnostic>& errors); // Best effort.
+		// Removes entries of other versions and temporary files older than temporaryLifetime, then the oldest entries until it's at most maxSize.
+		void trim(void);
+
+		static std::uint64_t hash(const std::string_view& content);
+
+	private:
+		std::filesystem::path pathOf(const std::string_view& source) const;
+
+		static constexpr std::chrono::minutes temporaryLifetime{ 10 }; // A store() takes far less, so an older temporary file was left by one that was interrupted.
+
+		std::filesystem::path m_directory;
+		std::uintmax_t m_maxSize;
+	};
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+namespace Lexer
+{
+	// Which family of tokens can start with a given byte.
+	// The Generator looks only at the first byte of a token and jumps straight to the extractors of that family.
+	enum class CharClass : std::uint8_t
+	{
+		INVALID,    // $, @, {, \r and ect. Can only end up as an "Invalid character" error.
+		SPACE,      // ' ', '\t'
+		NEW_LINE,   // \n
+		COMMENT,    // #
+		QUOTE,      // "Hello", """Hello"""
+		APOSTROPHE, // 'H'
+		ZERO,       // 0x, 0b, 0o or any other number.
+		DIGIT,      // 1-9
+		DOT,        // .5, .5e3 or the symbols '.' and '...'
+		WORD,       // a-z, A-Z, _ (Keywords, identifiers, True, None, and...)
+		PUNCTUATOR, // +, -, (, != and ect.
+	};
+
+	constexpr std::array<Lexer::CharClass, 256> makeCharClasses(void)
+	{
+		std::array<Lexer::CharClass, 256> classes{};
+		classes.fill(Lexer::CharClass::INVALID);
+
+		for (unsigned char c = 'a'; c <= 'z'; c++) classes[c] = Lexer::CharClass::WORD;
+		for (unsigned char c = 'A'; c <= 'Z'; c++) classes[c] = Lexer::CharClass::WORD;
+		for (unsigned char c = '1'; c <= '9'; c++) classes[c] = Lexer::CharClass::DIGIT;
+		for (unsigned char c : { '+', '-', '*', '/', '%', '<', '>', '|', '&', '^', '~', '=', ',', '(', ')', '[', ']', '?', ':', '!' })
+			classes[c] = Lexer::CharClass::PUNCTUATOR;
+
+		classes['_'] = Lexer::CharClass::WORD;
+		classes['0'] = Lexer::CharClass::ZERO;
+		classes['.'] = Lexer::CharClass::DOT;
+		classes['\"'] = Lexer::CharClass::QUOTE;
+		classes['\''] = Lexer::CharClass::APOSTROPHE;
+		classes['#'] = Lexer::CharClass::COMMENT;
+		classes['\n'] = Lexer::CharClass::NEW_LINE;
+		classes[' '] = Lexer::CharClass::SPACE;
+		classes['\t'] = Lexer::CharClass::SPACE;
+
+		return classes;
+	}
+
+	inline constexpr std::array<Lexer::CharClass, 256> charClasses = Lexer::makeCharClasses();
+}
@@ -0,0 +1,9 @@
+#include "../Lexer/Diagnostic.hpp"
+#include <format>
+
+std::string Lexer::Diagnostic::toString(void) const
+{
+    if (not this->line and this->code.empty()) return this->error;
+    if (not this->line) return std::format("{}: '{}'", this->error, this->code);
+    return std::format("At line: {}\nError: {}\n{}\n{:{}s}^", this->line, this->error, this->code, "", this->column);
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <cstddef>
+
+namespace Lexer
+{
+	// A lexing error. It's only formatted into text when it's needed (See toString),
+	// so its line can still be moved after it was made (See Lexer::Generator::lexParallel).
+	struct Diagnostic
+	{
+		std::size_t line; // 0 if it's about the whole source (Then only the error, and the code if there is one, is printed).
+		const char* error;
+		std::string_view code; // The line of the error without its indention. Points into the source like tokens do.
+		std::size_t column = 0; // Where the '^' goes under code.
+
+		std::string toString(void) const;
+	};
+}
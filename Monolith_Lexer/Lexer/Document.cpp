@@ -0,0 +1,143 @@
+#include "../Lexer/Document.hpp"
+#include "../Helper/Assert.hpp"
+#include <algorithm>
+#include <limits>
+#include <cstdint>
+
+Lexer::Document::Document(const std::string_view& text)
+    : m_text(text.begin(), text.end()), m_tokens(this->text())
+{
+    Assert_Message(this->m_text.size() <= std::numeric_limits<std::uint32_t>::max(), "Text is too big. 4 GiB at most");
+
+    this->m_checkpoints.emplace_back(Lexer::Scanner::State(), 0, 0);
+    this->lexFrom(0, 0, 0, {});
+}
+
+Lexer::Document::Change Lexer::Document::edit(std::size_t offset, std::size_t removedSize, const std::string_view& text)
+{
+    Assert_Message(offset <= this->m_text.size() and removedSize <= this->m_text.size() - offset, "Edit is out of the text");
+    Assert_Message(this->m_text.size() - removedSize + text.size() <= std::numeric_limits<std::uint32_t>::max(), "Text is too big. 4 GiB at most");
+
+    // The last checkpoint at (Or before) the edit. A state is only made of the bytes before it, so the edit can't change it.
+    auto it = std::upper_bound(this->m_checkpoints.begin(), this->m_checkpoints.end(), offset, [](std::size_t offset, const Checkpoint& checkpoint) -> bool
+    {
+        return offset < checkpoint.state.offset;
+    });
+    std::size_t first = std::distance(this->m_checkpoints.begin(), it) - 1;
+
+    // Errors point into the text, which can move. Keep their offsets.
+    std::vector<std::size_t> codeOffsets;
+    codeOffsets.reserve(this->m_errors.size());
+    for (const Lexer::Diagnostic& error : this->m_errors) codeOffsets.emplace_back(error.code.data() - this->m_text.data());
+
+    // Edit.
+    std::size_t common = std::min(removedSize, text.size());
+    std::copy(text.begin(), text.begin() + common, this->m_text.begin() + offset);
+    if (common < text.size()) this->m_text.insert(this->m_text.begin() + offset + removedSize, text.begin() + common, text.end());
+    else this->m_text.erase(this->m_text.begin() + offset + common, this->m_text.begin() + offset + removedSize);
+    this->m_tokens.rebase(this->text());
+
+    std::ptrdiff_t delta = static_cast<std::ptrdiff_t>(text.size()) - static_cast<std::ptrdiff_t>(removedSize);
+    return this->lexFrom(first, offset + text.size(), delta, codeOffsets);
+}
+
+std::string_view Lexer::Document::text(void) const
+{
+    return std::string_view(this->m_text.data(), this->m_text.size());
+}
+const Lexer::TokenList& Lexer::Document::tokens(void) const
+{
+    return this->m_tokens;
+}
+const std::vector<Lexer::Diagnostic>& Lexer::Document::errors(void) const
+{
+    return this->m_errors;
+}
+
+Lexer::Document::Change Lexer::Document::lexFrom(std::size_t first, std::size_t editEnd, std::ptrdiff_t delta, const std::vector<std::size_t>& codeOffsets)
+{
+    std::size_t tokenFirst = this->m_checkpoints[first].tokenIndex;
+    std::size_t errorFirst = this->m_checkpoints[first].errorIndex;
+
+    // Lex until a restart point after the edit is the same as an old one (Old checkpoints after first still have old offsets).
+    Lexer::Scanner scanner(this->text(), this->m_checkpoints[first].state);
+    Lexer::TokenList tokens(this->text());
+    std::vector<Checkpoint> checkpoints;
+    std::size_t old = first + 1;
+    bool isLinedUp = false;
+    std::ptrdiff_t linesDelta = 0;
+    std::size_t lastOffset = this->m_checkpoints[first].state.offset;
+    while (auto opt = scanner.next())
+    {
+        tokens.push_back(opt.value());
+        if (opt.value().tag != Lexer::Tag::NEW_LINE or not scanner.isAtRestartPoint()) continue;
+
+        // Lined up with an old checkpoint?
+        std::size_t offset = scanner.offset();
+        if (offset >= editEnd)
+        {
+            std::size_t oldOffset = offset - delta;
+            while (old < this->m_checkpoints.size() and this->m_checkpoints[old].state.offset < oldOffset) old++;
+            if (old < this->m_checkpoints.size() and this->m_checkpoints[old].state.offset == oldOffset)
+            {
+                Lexer::Scanner::State state = scanner.state();
+                if (Lexer::Document::isSameState(state, this->m_checkpoints[old].state, delta))
+                {
+                    isLinedUp = true;
+                    linesDelta = static_cast<std::ptrdiff_t>(state.linesCount) - static_cast<std::ptrdiff_t>(this->m_checkpoints[old].state.linesCount);
+                    break;
+                }
+            }
+        }
+
+        if (offset - lastOffset < Lexer::Document::checkpointSpacing) continue;
+        checkpoints.emplace_back(scanner.state(), tokenFirst + tokens.size(), errorFirst + scanner.errors().size());
+        lastOffset = offset;
+    }
+    if (not isLinedUp) old = this->m_checkpoints.size();
+
+    // Tokens.
+    std::size_t tokenLast = isLinedUp ? this->m_checkpoints[old].tokenIndex : this->m_tokens.size();
+    this->m_tokens.replace(tokenFirst, tokenLast, tokens);
+    this->m_tokens.shift(tokenFirst + tokens.size(), delta);
+
+    // Errors.
+    const char* base = this->m_text.data();
+    std::size_t errorLast = isLinedUp ? this->m_checkpoints[old].errorIndex : this->m_errors.size();
+    for (std::size_t i = 0; i < errorFirst; i++)
+    {
+        this->m_errors[i].code = std::string_view(base + codeOffsets[i], this->m_errors[i].code.size());
+    }
+    for (std::size_t i = errorLast; i < this->m_errors.size(); i++)
+    {
+        this->m_errors[i].code = std::string_view(base + codeOffsets[i] + delta, this->m_errors[i].code.size());
+        this->m_errors[i].line += linesDelta;
+    }
+    std::vector<Lexer::Diagnostic> errors = scanner.takeErrors();
+    this->m_errors.erase(this->m_errors.begin() + errorFirst, this->m_errors.begin() + errorLast);
+    this->m_errors.insert(this->m_errors.begin() + errorFirst, errors.begin(), errors.end());
+
+    // Checkpoints.
+    std::ptrdiff_t tokensDelta = static_cast<std::ptrdiff_t>(tokens.size()) - static_cast<std::ptrdiff_t>(tokenLast - tokenFirst);
+    std::ptrdiff_t errorsDelta = static_cast<std::ptrdiff_t>(errors.size()) - static_cast<std::ptrdiff_t>(errorLast - errorFirst);
+    for (std::size_t i = old; i < this->m_checkpoints.size(); i++)
+    {
+        Checkpoint& checkpoint = this->m_checkpoints[i];
+        checkpoint.state.offset += delta;
+        checkpoint.state.currentLineOffset += delta;
+        checkpoint.state.linesCount += linesDelta;
+        checkpoint.tokenIndex += tokensDelta;
+        checkpoint.errorIndex += errorsDelta;
+    }
+    this->m_checkpoints.erase(this->m_checkpoints.begin() + first + 1, this->m_checkpoints.begin() + old);
+    this->m_checkpoints.insert(this->m_checkpoints.begin() + first + 1, std::make_move_iterator(checkpoints.begin()), std::make_move_iterator(checkpoints.end()));
+
+    return Lexer::Document::Change{ tokenFirst, tokenLast - tokenFirst, tokens.size() };
+}
+
+bool Lexer::Document::isSameState(const Lexer::Scanner::State& state, const Lexer::Scanner::State& oldState, std::ptrdiff_t delta)
+{
+    // Only the line count can be different (The edit can add or remove lines). It doesn't change the tokens.
+    return state.offset == oldState.offset + delta and state.depthClosingCount == oldState.depthClosingCount
+        and state.shouldCheckIndentFlag == oldState.shouldCheckIndentFlag and state.identLevels == oldState.identLevels;
+}
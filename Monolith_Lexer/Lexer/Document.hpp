@@ -0,0 +1,62 @@
+#pragma once
+#include "../Lexer/TokenList.hpp"
+#include "../Lexer/Diagnostic.hpp"
+#include "../Lexer/Scanner.hpp"
+
+#include <vector>
+#include <string_view>
+#include <cstddef>
+
+namespace Lexer
+{
+	// An editable source and its tokens, for editors that lex on every keystroke.
+	// An edit is only lexed from the last restart point before it (See Lexer::Scanner::isAtRestartPoint),
+	// and lexing stops at the first restart point after it where the state is the same as before the edit.
+	// The tokens and errors after that point are kept, only their offsets (and lines) are moved.
+	class Document
+	{
+	public:
+		// Tokens [first, first + removedCount) of before the edit are now [first, first + insertedCount).
+		struct Change
+		{
+			std::size_t first;
+			std::size_t removedCount;
+			std::size_t insertedCount;
+		};
+
+		Document(const std::string_view& text = {});
+		Document(Lexer::Document&&) noexcept = default;
+		Lexer::Document& operator = (Lexer::Document&&) noexcept = default;
+		Document(const Lexer::Document&) = delete;
+		Lexer::Document& operator = (const Lexer::Document&) = delete;
+
+		Lexer::Document::Change edit(std::size_t offset, std::size_t removedSize, const std::string_view& text); // [offset, offset + removedSize) becomes text.
+
+		std::string_view text(void) const;
+		const Lexer::TokenList& tokens(void) const; // Points into text().
+		const std::vector<Lexer::Diagnostic>& errors(void) const;
+
+	private:
+		// A restart point and where the tokens and errors after it start.
+		struct Checkpoint
+		{
+			Lexer::Scanner::State state;
+			std::size_t tokenIndex;
+			std::size_t errorIndex;
+		};
+
+		// Lexes from m_checkpoints[first] until a restart point at (Or after) editEnd is the same as an old checkpoint moved by delta.
+		// Then puts the new tokens, errors and checkpoints instead of the old ones. codeOffsets are the offsets of the errors before the edit.
+		Lexer::Document::Change lexFrom(std::size_t first, std::size_t editEnd, std::ptrdiff_t delta, const std::vector<std::size_t>& codeOffsets);
+
+		static bool isSameState(const Lexer::Scanner::State& state, const Lexer::Scanner::State& oldState, std::ptrdiff_t delta);
+
+		// Fewer checkpoints make edits lex a bit more, but there are less of them to move after every edit.
+		static constexpr std::size_t checkpointSpacing = 1 << 10; // Bytes.
+
+		std::vector<char> m_text; // Not std::string, small strings would live inside the object and move with it.
+		Lexer::TokenList m_tokens;
+		std::vector<Lexer::Diagnostic> m_errors;
+		std::vector<Checkpoint> m_checkpoints; // Sorted by offset. The first one is always the start of the text.
+	};
+}
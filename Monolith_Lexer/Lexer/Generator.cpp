@@ -1,886 +1,289 @@
 #include "../Lexer/Generator.hpp"
-#include "../Helper/Helper.hpp"
-#include "../Helper/Assert.hpp"
+#include "../Lexer/Scanner.hpp"
+#include "../Lexer/Writer.hpp"
+#include "../Helper/SourceFile.hpp"
+#include "../Helper/ThreadPool.hpp"
 #include <algorithm>
-#include <exception>
-#include <stdexcept>
-#include <array>
-#include <iterator>
-#include <cctype>
-#include <cmath>
+#include <limits>
+#include <cstdint>
 
 // Blessed be You, O my Lord. Our God, King of the world.
 // That he shall protect this code from bugs and undefined behavior. Amen :)
 
-Lexer::Generator::Generator(const char* filename) : m_filename(filename)
+Lexer::Generator::Generator(const char* filename, std::size_t threadCount, Lexer::Interner* interner, Lexer::Cache* cache, bool shouldDecodeLiterals,
+    std::pmr::memory_resource* resource)
+    : Lexer::Generator(Helper::SourceFile::open(filename), filename, threadCount, interner, cache, shouldDecodeLiterals, resource)
 {
-    if (auto opt = Helper::extractFileContent(filename))
-    {
-        this->m_file = opt.value();
-    }
-    else
-    {
-        this->m_errors.emplace_back(std::format("Could not open file: '{}'", filename));
-        return;
-    }
-
-    // Scan for weird chars.
-    for (unsigned char c : this->m_file)
-    {
-        if (not std::isprint(c) and not std::iscntrl(c))
-        {
-            // I ain't doing UTF16.
-            this->m_errors.emplace_back("Unprintable chars. UTF16 is probably used");
-            return;
-        }
-    }
-
-    // For lexering.
-    std::string_view view = this->m_file;
-    std::stack<std::size_t> identLevels;
-    std::size_t depthClosingCount = 0; // Checks the depth of ( and [ . Useful for stuff like if ((x < 7) and (1 == 3)):
-    bool shouldCheckIndentFlag = true;
-    
-    // For errors.
-    std::size_t linesCount = 1;
-    std::string_view currentLine;
-    if (auto opt2 = Lexer::Generator::extractUntilNewLine(view)) currentLine = opt2.value();
-
-    // Guidelines: 
-    // 1. Every (with exceptions) extract'XTag' must start with this code chunk.
-    // std::string_view fixedView;
-    // if (auto opt = Lexer::Generator::extractUntilNewLine(view)) fixedView = opt.value();
-    // else return std::nullopt;
-    // And later code only use fixedView and not view. Only after 100% of extracting/scanning everything you are allowed to do view.remove_prefix(x);
-    // This is to avoid chars after the \n. (Please even if it seams not unnecessary or slow or unoptimized keep it).
-    // 2. If you perform multiple scans in one function keep a variable named std::size_t totalSize = 0; as the first chunk above them.
-    // This will make it easier to know at which column to report errors or just calculate sizes. This is not a must but recommended.
-    // Also make sure that you do 'totalSize++' next to something like 'i++' eg: for (...; ...; i++, totalSize++).
-
-    // How this lexer work?
-    // Basic concept: I first skip all the spaces and scan the current word I have to matching possible tokens one by one.
-    // If it match I append to the tokens. Else I check other tokens.
-    // Extra more complex concept: Every '\n' I check for indention level (number of spaces and tabs).
-    // If I ecounter a (... or [... I stop this checking until I find an ending ...) or ...].
-
-    while (not view.empty())
-    {
-        try
-        {
-            // Newline must be first.
-            // This avoids the other extract function getting a string like that "\nx = 1234" and converting it into "".
-            // This could prevent bugs.
-            if (auto opt = Lexer::Generator::extractNewLine(view))
-            {
-                if (auto opt2 = Lexer::Generator::extractUntilNewLine(view)) currentLine = opt2.value();
-                linesCount++;
-                shouldCheckIndentFlag = true;
-                this->m_tokens.emplace_back(opt.value());
-                continue;
-            }
-
-            // Sorry for this ugly nesting. It's required and there is no better way to do it.
-            if (shouldCheckIndentFlag) // If newline and no closing depth.
-            {
-                if (not depthClosingCount) // This is nested here and not if (shouldCheckIndentFlag and not depthClosingCount) above. To make shouldCheckIndentFlag = false;.
-                {
-                    if (auto opt = Lexer::Generator::extractInDedent(view, identLevels))
-                    {
-                        for (auto& token : opt.value())
-                            this->m_tokens.emplace_back(std::move(token));
-                    }
-                }
-                shouldCheckIndentFlag = false;
-                continue;
-            }
-
-            Lexer::Generator::skipSpaces(view);
-
-            // This ugly if .., continue is to keep 'auto opt' in the scope of the single 'if'.
-            if (auto opt = Lexer::Generator::extractString3Literal(view))
-            {
-                this->m_tokens.emplace_back(opt.value());
-                continue;
-            }
-            if (auto opt = Lexer::Generator::extractStringLiteral(view))
-            {
-                this->m_tokens.emplace_back(opt.value());
-                continue;
-            }
-            if (auto opt = Lexer::Generator::extractCharLiteral(view))
-            {
-                this->m_tokens.emplace_back(opt.value());
-                continue;
-            }
-            if (auto opt = Lexer::Generator::extractHexLiteral(view))
-            {
-                this->m_tokens.emplace_back(opt.value());
-                continue;
-            }
-            if (auto opt = Lexer::Generator::extractBinLiteral(view))
-            {
-                this->m_tokens.emplace_back(opt.value());
-                continue;
-            }
-            if (auto opt = Lexer::Generator::extractOctLiteral(view))
-            {
-                this->m_tokens.emplace_back(opt.value());
-                continue;
-            }
-            if (auto opt = Lexer::Generator::extractSciLiteral(view))
-            {
-                this->m_tokens.emplace_back(opt.value());
-                continue;
-            }
-            // Float before int because a string like this "1234.1234" will become: [INT_LITERAL: '1234'], [SYMBOL: '.'], [INT_LITERAL: '1234']
-            if (auto opt = Lexer::Generator::extractFloatLiteral(view))
-            {
-                this->m_tokens.emplace_back(opt.value());
-                continue;
-            }
-            if (auto opt = Lexer::Generator::extractIntLiteral(view))
-            {
-                this->m_tokens.emplace_back(opt.value());
-                continue;
-            }
-            if (auto opt = Lexer::Generator::extractBoolLiteral(view))
-            {
-                this->m_tokens.emplace_back(opt.value());
-                continue;
-            }
-            if (auto opt = Lexer::Generator::extractNoneLiteral(view))
-            {
-                this->m_tokens.emplace_back(opt.value());
-                continue;
-            }
-            if (auto opt = Lexer::Generator::extractSymbol(view, depthClosingCount))
-            {
-                this->m_tokens.emplace_back(opt.value());
-                continue;
-            }
-            if (auto opt = Lexer::Generator::extractKeyword(view))
-            {
-                this->m_tokens.emplace_back(opt.value());
-                continue;
-            }
-            if (auto opt = Lexer::Generator::extractIdentifier(view))
-            {
-                this->m_tokens.emplace_back(opt.value());
-                continue;
-            }
-
-            // This section happens if it's a comment. 
-            Lexer::Generator::incrementToNextLine(view);
-            if (auto opt2 = Lexer::Generator::extractUntilNewLine(view)) currentLine = opt2.value();
-            linesCount++;
-        }
-        catch (const Lexer::Generator::Error& error)
-        {
-            std::string_view fixedLine = currentLine;
-            Lexer::Generator::skipSpaces(fixedLine);
-
-            std::size_t distance;
-            if (error.column == std::string_view::npos)
-            {
-                distance = 0;
-            }
-            else
-            {
-                distance = std::abs((view.data() - fixedLine.data())) + error.column;
-            }
-            this->m_errors.emplace_back(std::format("At line: {}\nError: {}\n{}\n{:{}s}^", linesCount, error.error, fixedLine, "", distance));
-            
-            Lexer::Generator::incrementToNextLine(view);
-            if (auto opt2 = Lexer::Generator::extractUntilNewLine(view)) currentLine = opt2.value();
-            linesCount++;
-        }
-        catch (const std::exception& error)
-        {
-            Assert_Message(ASSERT_ALWAYS, error.what());
-        }
-    }
 }
-
-bool Lexer::Generator::empty(void) const
-{
-    return this->m_tokens.empty();
-}
-std::size_t Lexer::Generator::size(void) const
+Lexer::Generator::Generator(Helper::SourceFile&& source, const char* name, std::size_t threadCount, Lexer::Interner* interner, Lexer::Cache* cache,
+    bool shouldDecodeLiterals, std::pmr::memory_resource* resource)
+    : Lexer::Generator(std::optional<Helper::SourceFile>(std::move(source)), name, threadCount, interner, cache, shouldDecodeLiterals, resource)
 {
-    return this->m_tokens.size();
-}
-const Lexer::Token& Lexer::Generator::operator [] (std::size_t index) const
-{
-    return this->m_tokens[index];
 }
-std::vector<Lexer::Token>::const_iterator Lexer::Generator::begin(void) const
-{
-    return this->m_tokens.begin();
-}
-std::vector<Lexer::Token>::const_iterator Lexer::Generator::end(void) const
-{
-    return this->m_tokens.end();
-}
-
-bool Lexer::Generator::didPass(void) const
+Lexer::Generator::Generator(std::optional<Helper::SourceFile>&& source, const char* filename, std::size_t threadCount, Lexer::Interner* interner, Lexer::Cache* cache,
+    bool shouldDecodeLiterals, std::pmr::memory_resource* resource)
+    : m_filename(filename), m_tokens({}, resource), m_lines({}, resource), m_isCacheHit(false), m_shouldDecodeLiterals(shouldDecodeLiterals)
 {
-    return this->m_errors.empty();
-}
-
-void Lexer::Generator::skipSpaces(std::string_view& view)
-{
-    while (not view.empty() and (view.front() == ' ' or view.front() == '\t')) 
-        view.remove_prefix(1);
-}
-void Lexer::Generator::incrementToNextLine(std::string_view& view)
-{
-    while (not view.empty() and (view.front() != '\n')) view.remove_prefix(1);
-    if (not view.empty()) view.remove_prefix(1);
-}
-
-std::optional<std::size_t> Lexer::Generator::extractSpacesLevel(const std::string_view& view)
-{
-    // Scan.
-    std::string_view temp = view;
-    std::size_t level = 0;
-    while (not temp.empty() and (temp.front() == ' ' or temp.front() == '\t'))
+    if (source)
     {
-        level += temp.front() == ' ';
-        level += (temp.front() == '\t') * 4;
-        temp.remove_prefix(1);
+        this->m_source = std::move(source.value());
+        this->m_file = this->m_source.view();
     }
-    if (not temp.empty() and (temp.front() == '\n' or temp.front() == '#')) return std::nullopt; // If empty string or is a comment.
-
-    // Return.
-    return level;
-}
-std::optional<std::string_view> Lexer::Generator::extractUntilNewLine(const std::string_view& view)
-{
-    // Scan.
-    std::size_t newLinePos = view.find('\n');
-    std::string_view content = view;
-    if (newLinePos != std::string_view::npos)
+    else
     {
-        content = view.substr(0, newLinePos);
+        this->m_errors.emplace_back(0, "Could not open file", filename);
+        return;
     }
-    if (content.empty()) return std::nullopt;
 
-    // Return.
-    return content;
-}
-std::optional<std::string_view> Lexer::Generator::extractUntilNotAlnum(const std::string_view& view)
-{
-    // Forced Code.
-    std::string_view fixedView;
-    if (auto opt = Lexer::Generator::extractUntilNewLine(view)) fixedView = opt.value();
-    else return std::nullopt;
-    
-    // Scan.
-    std::size_t i = 0;
-    for (i = 0; i < fixedView.size(); i++)
+    // Scan for weird chars.
+    if (not Lexer::Scanner::isPrintable(this->m_file))
     {
-        unsigned char c = static_cast<unsigned char>(fixedView[i]);
-        if (not std::isalnum(c) and c != '_')
-        {
-            break;
-        }
+        this->m_errors.emplace_back(0, "Unprintable chars. UTF16 is probably used");
+        return;
     }
-    if (i == 0) return std::nullopt;
-
-    // Return.
-    return fixedView.substr(0, i);
-}
-
-std::optional<Lexer::Token> Lexer::Generator::extractString3Literal(std::string_view& view)
-{
-    // Early return.
-    if (not view.starts_with("\"\"\"")) return std::nullopt;
 
-    // Scan.
-    std::size_t endPos = view.find("\"\"\"", std::strlen("\"\"\""));
-    if (endPos == std::string_view::npos)
+    // Tokens only keep 32-bit offsets (See Lexer::TokenList).
+    if (this->m_file.size() > std::numeric_limits<std::uint32_t>::max())
     {
-        throw Lexer::Generator::Error("Triple string literal does not end");
+        this->m_errors.emplace_back(0, "File is too big. 4 GiB at most");
+        return;
     }
-    endPos += std::strlen("\"\"\"");
-    std::string_view string3Literal = view.substr(0, endPos);
-
-    // Incrementation & return.
-    std::string_view content = string3Literal;
-    view.remove_prefix(endPos);
-    return Lexer::Token(Lexer::Tag::STRING3_LITERAL, content);
-}
-std::optional<Lexer::Token> Lexer::Generator::extractStringLiteral(std::string_view& view)
-{
-    // Forced Code.
-    std::string_view fixedView;
-    if (auto opt = Lexer::Generator::extractUntilNewLine(view)) fixedView = opt.value();
-    else return std::nullopt;
 
-    // Early return.
-    if (not (fixedView.front() == '\"')) return std::nullopt;
+    // Same resource as the members, so these are moved in and not copied (See Lexer::TokenList).
+    this->m_lines = Lexer::LineTable(this->m_file, resource);
 
-    // Scan.
-    char prev = ' ';
-    auto endPosIt = std::find_if(fixedView.begin() + 1, fixedView.end(), [&prev] (char c) -> bool
-    {
-        if (c == '\"' and prev != '\\')
-        {
-            return true;
-        }
+    // A stream has no literals, and the errors differ (A number that doesn't fit is only an error when decoded).
+    if (shouldDecodeLiterals) cache = nullptr;
 
-        prev = c;
-        return false;
-    });
-    if (endPosIt == fixedView.end())
+    std::optional<Lexer::TokenStream> cached;
+    if (cache)
     {
-        throw Lexer::Generator::Error("String literal does not end at current line");
+        cached = cache->find(this->m_file);
     }
-    std::size_t endPos = std::distance(fixedView.begin(), endPosIt) + std::strlen("\"");
-    std::string_view stringLiteral = fixedView.substr(0, endPos);
-
-    // Incrementation & return.
-    std::string_view content = stringLiteral;
-    view.remove_prefix(endPos);
-    return Lexer::Token(Lexer::Tag::STRING_LITERAL, content);
-}
-std::optional<Lexer::Token> Lexer::Generator::extractCharLiteral(std::string_view& view)
-{
-    // Forced Code.
-    std::string_view fixedView;
-    if (auto opt = Lexer::Generator::extractUntilNewLine(view)) fixedView = opt.value();
-    else return std::nullopt;
-
-    // Early return.
-    if (not (fixedView.front() == '\'')) return std::nullopt;
-
-    // Scan.
-    char prev = ' ';
-    auto endPosIt = std::find_if(fixedView.begin() + 1, fixedView.end(), [&prev](char c) -> bool
-    {
-        if (c == '\'' and prev != '\\')
-        {
-            return true;
-        }
-
-        prev = c;
-        return false;
-    });
-    if (endPosIt == fixedView.end())
+    if (cached)
     {
-        throw Lexer::Generator::Error("Character literal does not end at current line");
+        // The errors point into the mapped entry, which the tokens keep from here (Its columns are adopted, not copied).
+        this->m_errors = cached->errors();
+        this->m_tokens = Lexer::TokenList(this->m_file, std::move(cached.value()), resource);
+        this->m_isCacheHit = true;
     }
-    std::size_t endPos = std::distance(fixedView.begin(), endPosIt) + std::strlen("\'");
-    std::string_view charLiteral = fixedView.substr(0, endPos);
-    if (charLiteral.size() >= 2 // Bounds checking.
-        and charLiteral.size() > (std::strlen("'a'") + (charLiteral[1] == '\\'))) // Checks if it's bypassing the length of 'a' or the length of '\n' if there was a '\' before.
-        throw Lexer::Generator::Error("Character literal is more than character", std::strlen("'a") + (charLiteral[1] == '\\')); // I did not mistake with "'a" it doesn't end with an ' on purpose.
-
-    // Incrementation & return.
-    std::string_view content = charLiteral;
-    view.remove_prefix(endPos);
-    return Lexer::Token(Lexer::Tag::CHAR_LITERAL, content);
-}
-std::optional<Lexer::Token> Lexer::Generator::extractHexLiteral(std::string_view& view)
-{
-    // Forced Code.
-    std::size_t totalSize = 0;
-    std::string_view fixedView;
-    if (auto opt = Lexer::Generator::extractUntilNewLine(view)) fixedView = opt.value();
-    else return std::nullopt;
-
-    // Early errors/return.
-    if ((not fixedView.starts_with("0x") and not fixedView.starts_with("0X"))) return std::nullopt;
-    if (fixedView.size() <= 2) throw Lexer::Generator::Error("Invalid hexadecimal literal");
-    totalSize += std::strlen("0x");
-
-    // Scan.
-    std::string_view afterSignature = fixedView.substr(totalSize);
-    for (afterSignature; not afterSignature.empty(); afterSignature.remove_prefix(1), totalSize++)
+    else
     {
-        unsigned char c = static_cast<unsigned char>(afterSignature.front());
+        this->m_tokens = Lexer::TokenList(this->m_file, resource);
+        if (shouldDecodeLiterals) this->m_tokens.keepLiterals();
+        if (threadCount > 1 and this->m_file.size() >= 2 * Lexer::Generator::minChunkSize) this->lexParallel(threadCount);
+        else this->lexSerial();
 
-        if (not std::isalnum(c)) break;
-        if (std::string_view("0123456789ABCDEFabcdef").find(c) == std::string_view::npos) throw Lexer::Generator::Error("Invalid hexadecimal literal", totalSize);
+        // Before interning. IDs are only valid with the interner that made them.
+        if (cache) cache->store(this->m_file, this->m_tokens, this->m_errors);
     }
 
-    // Incrementation & return.
-    std::string_view content = fixedView.substr(0, totalSize);
-    view.remove_prefix(content.size());
-    return Lexer::Token(Lexer::Tag::HEX_LITERAL, content);
+    // Once for the whole file, so a shared interner is locked once (See Lexer::Interner).
+    if (interner) this->m_tokens.intern(*interner);
 }
 
-std::optional<Lexer::Token> Lexer::Generator::extractBinLiteral(std::string_view& view)
+void Lexer::Generator::lexSerial(void)
 {
-    std::size_t totalSize = 0;
-    std::string_view fixedView;
-    if (auto opt = Lexer::Generator::extractUntilNewLine(view)) fixedView = opt.value();
-    else return std::nullopt;
-
-    // Early return.
-    if ((not fixedView.starts_with("0b") and not fixedView.starts_with("0B"))) return std::nullopt;
-    if (fixedView.size() <= 2) throw Lexer::Generator::Error("Invalid binary literal");
-    totalSize += std::strlen("0b");
-
-    // Scan.
-    std::string_view afterSignature = fixedView.substr(totalSize);
-    for (afterSignature; not afterSignature.empty(); afterSignature.remove_prefix(1), totalSize++)
+    // Lexering (See Lexer::Scanner). Reserved by size, so push_back almost never allocates.
+    this->m_tokens.reserve(this->m_file.size() / Lexer::Generator::minBytesPerToken + 1);
+    Lexer::Scanner scanner(this->m_file);
+    if (this->m_shouldDecodeLiterals) scanner.decodeLiterals();
+    while (auto opt = scanner.next())
     {
-        unsigned char c = static_cast<unsigned char>(afterSignature.front());
-
-        if (not std::isalnum(c)) break;
-        if (std::string_view("01").find(c) == std::string_view::npos) throw Lexer::Generator::Error("Invalid binary literal", totalSize);
+        this->m_tokens.push_back(opt.value());
     }
-
-    // Incrementation & return.
-    std::string_view content = fixedView.substr(0, totalSize);
-    view.remove_prefix(content.size());
-    return Lexer::Token(Lexer::Tag::BIN_LITERAL, content);
+    this->m_errors = scanner.takeErrors();
+    this->m_stats = scanner.stats();
 }
-std::optional<Lexer::Token> Lexer::Generator::extractOctLiteral(std::string_view& view)
-{
-    // Forced Code.
-    std::size_t totalSize = 0;
-    std::string_view fixedView;
-    if (auto opt = Lexer::Generator::extractUntilNewLine(view)) fixedView = opt.value();
-    else return std::nullopt;
 
-    // Early return.
-    if ((not fixedView.starts_with("0o") and not fixedView.starts_with("0O"))) return std::nullopt;
-    if (fixedView.size() <= 2) throw Lexer::Generator::Error("Invalid octal literal");
-    totalSize += std::strlen("0o");
-
-    // Scan.
-    std::string_view afterSignature = fixedView.substr(totalSize);
-    for (afterSignature; not afterSignature.empty(); afterSignature.remove_prefix(1), totalSize++)
-    {
-        unsigned char c = static_cast<unsigned char>(afterSignature.front());
-
-        if (not std::isalnum(c)) break;
-        if (std::string_view("01234567").find(c) == std::string_view::npos) throw Lexer::Generator::Error("Invalid octal literal", totalSize);
-    }
-
-    // Incrementation & return.
-    std::string_view content = fixedView.substr(0, totalSize);
-    view.remove_prefix(content.size());
-    return Lexer::Token(Lexer::Tag::OCT_LITERAL, content);
-}
-std::optional<Lexer::Token> Lexer::Generator::extractSciLiteral(std::string_view& view)
+// How the parallel lexing work?
+// The file is cut into chunks at lines with no indention (See findChunkStart), and every chunk is lexed in parallel
+// as if nothing came before it (No open indents, no open ( or [, and the line count of the physical line).
+// Then the chunks are stitched in order. The real state at the end of the previous chunk tells if the guess was right:
+// 1. It stopped right at the chunk start, outside of any ( or [, and the indention is checked on the next line.
+//    Then the only difference is the indent stack, and the first line of the chunk has no indention so it closes all of it.
+//    Those DEDENTs are added in front, and the lines of the errors are moved by how much the line count was off
+//    (A triple string literal doesn't count its lines).
+// 2. Anything else (A triple string literal that crosses the chunk start, an open ( or [, or a comment on the line before).
+//    Then the chunk is lexed again from the real state. Same as the serial lexer, just slower.
+void Lexer::Generator::lexParallel(std::size_t threadCount)
 {
-    // Forced Code.
-    std::size_t totalSize = 0;
-    std::string_view fixedView;
-    if (auto opt = Lexer::Generator::extractUntilNewLine(view)) fixedView = opt.value();
-    else return std::nullopt;
-
-    // Early return.
-    if (fixedView.size() <= 2) return std::nullopt;
-    if (fixedView.front() == '.' and not std::isdigit(static_cast<unsigned char>(fixedView[1]))) return std::nullopt; // '.a'
-    if (fixedView[1] == '.' and not std::isdigit(static_cast<unsigned char>(fixedView.front()))) return std::nullopt; // 'a.'
-    if (fixedView.front() != '.' and not std::isdigit(static_cast<unsigned char>(fixedView.front()))) return std::nullopt; // 'a'
-
-    // Scan 1.
-    bool seenE = false;
-    bool seenDot = false;
-    for (std::size_t i = 0; i < fixedView.size(); i++, totalSize++)
+    // Cut.
+    std::size_t chunkCount = std::min(threadCount, this->m_file.size() / Lexer::Generator::minChunkSize);
+    std::vector<std::size_t> starts{ 0 };
+    for (std::size_t i = 1; i < chunkCount; i++)
     {
-        unsigned char c = std::tolower(static_cast<unsigned char>(fixedView[i]));
-
-        if (c == 'e')
+        std::size_t start = this->findChunkStart(this->m_file.size() / chunkCount * i);
+        if (start > starts.back() and start < this->m_file.size()) starts.emplace_back(start);
+    }
+    starts.emplace_back(this->m_file.size());
+
+    struct Chunk
+    {
+        Lexer::TokenList tokens;
+        std::vector<Lexer::Diagnostic> errors;
+        Lexer::Scanner::State end;
+        Lexer::Stats stats; // Of the guess and of the second lexing, both are work that was done.
+    };
+    std::vector<Chunk> chunks(starts.size() - 1);
+    auto lexChunk = [this, &starts, &chunks](std::size_t index, const Lexer::Scanner::State& state)
+    {
+        // The default resource, the one of the Generator is only for its own thread. The chunks are copied into it anyway.
+        Chunk& chunk = chunks[index];
+        chunk.tokens = Lexer::TokenList(this->m_file);
+        chunk.tokens.reserve((starts[index + 1] - starts[index]) / Lexer::Generator::minBytesPerToken + 1);
+        if (this->m_shouldDecodeLiterals) chunk.tokens.keepLiterals();
+
+        Lexer::Scanner scanner(this->m_file, state, starts[index + 1]);
+        if (this->m_shouldDecodeLiterals) scanner.decodeLiterals();
+        while (auto opt = scanner.next())
         {
-            seenE = true;
-            break;
+            chunk.tokens.push_back(opt.value());
         }
+        chunk.errors = scanner.takeErrors();
+        chunk.end = scanner.state();
+        chunk.stats.merge(scanner.stats());
+    };
 
-        if (c == '.')
-        {
-            if (seenDot)
-            {
-                throw Lexer::Generator::Error("Invalid float literal", totalSize);
-            }
-            seenDot = true;
-            continue;
-        }
-
-        if (std::isalpha(c))
+    // Guess.
+    {
+        Helper::ThreadPool pool(std::min(threadCount, chunks.size()));
+        for (std::size_t i = 0; i < chunks.size(); i++)
         {
-            if (seenDot)
+            pool.submit([this, &starts, &lexChunk, i]
             {
-                throw Lexer::Generator::Error("Invalid float literal", totalSize);
-            }
-            throw Lexer::Generator::Error("Invalid integer literal", totalSize); // If there was no dot it means it's an int literal.
+                Lexer::Scanner::State state;
+                state.offset = starts[i];
+                state.currentLineOffset = starts[i];
+                state.linesCount = this->m_lines.indexOf(starts[i]) + 1;
+                lexChunk(i, state);
+            });
         }
-        if (not std::isalnum(c)) break;
-    }
-    if (not seenE) return std::nullopt;
-    totalSize += std::strlen("e");
-
-    std::string_view afterE = fixedView.substr(totalSize);
-    if (afterE.empty()) throw Lexer::Generator::Error("Invalid scientific notation literal", totalSize);
-
-    // Scan 2.
-    if (afterE.front() == '+' or afterE.front() == '-')
-    {
-        afterE.remove_prefix(1);
-        totalSize++;
-    }
-    bool seen = false;
-    for (afterE; not afterE.empty(); afterE.remove_prefix(1), totalSize++)
-    {
-        unsigned char c = std::tolower(static_cast<unsigned char>(afterE.front()));
-
-        if (std::isalpha(c)) throw Lexer::Generator::Error("Invalid scientific notation literal", totalSize);
-        if (not std::isalnum(c)) break;
-
-        seen = true;
+        pool.wait();
     }
-    if (not seen) throw Lexer::Generator::Error("Invalid scientific notation literal", totalSize);
-
-    // Incrementation & return.
-    std::string_view content = fixedView.substr(0, totalSize);
-    view.remove_prefix(content.size());
-    return Lexer::Token(Lexer::Tag::SCI_LITERAL, content);
-}
-std::optional<Lexer::Token> Lexer::Generator::extractFloatLiteral(std::string_view& view)
-{
-    // Forced Code.
-    std::string_view fixedView;
-    if (auto opt = Lexer::Generator::extractUntilNewLine(view)) fixedView = opt.value();
-    else return std::nullopt;
 
-    // Early return.
-    if (fixedView.size() <= 1) return std::nullopt;
-    if (fixedView.front() == '.' and not std::isdigit(static_cast<unsigned char>(fixedView[1]))) return std::nullopt; // '.a'
-    if (fixedView[1] == '.' and not std::isdigit(static_cast<unsigned char>(fixedView.front()))) return std::nullopt; // 'a.'
-    if (fixedView.front() != '.' and not std::isdigit(static_cast<unsigned char>(fixedView.front()))) return std::nullopt; // 'a'
+    // Stitch. The first chunk starts at the start of the file, so its guess is always right.
+    std::size_t tokensCount = 0;
+    for (const Chunk& chunk : chunks) tokensCount += chunk.tokens.size();
+    this->m_tokens.reserve(tokensCount);
 
-    // Scan.
-    bool seenDot = false;
-    std::size_t i = 0;
-    for (i = 0; i < fixedView.size(); i++)
+    Lexer::Scanner::State state;
+    for (std::size_t i = 0; i < chunks.size(); i++)
     {
-        unsigned char c = static_cast<unsigned char>(fixedView[i]);
-
-        if (c == '.')
+        Chunk& chunk = chunks[i];
+        if (state.offset == starts[i] and state.shouldCheckIndentFlag and not state.depthClosingCount)
         {
-            if (seenDot)
+            // At the start of the chunk, where the serial lexer would put them (Chunks start with no indention).
+            for (std::size_t j = 0; j < state.identLevels.size(); j++)
             {
-                throw Lexer::Generator::Error("Invalid float literal", i);
+                this->m_tokens.push_back(Lexer::Token(Lexer::Tag::DEDENT, this->m_file.substr(starts[i], 0)));
             }
-            seenDot = true;
-            continue;
-        }
 
-        if (std::isalpha(c))
+            std::size_t guessedLinesCount = this->m_lines.indexOf(starts[i]) + 1;
+            for (Lexer::Diagnostic& error : chunk.errors) error.line = error.line - guessedLinesCount + state.linesCount;
+            chunk.end.linesCount = chunk.end.linesCount - guessedLinesCount + state.linesCount;
+        }
+        else
         {
-            if (seenDot)
-            {
-                throw Lexer::Generator::Error("Invalid float literal", i);
-            }
-            throw Lexer::Generator::Error("Invalid integer literal", i); // If there was no dot it means it's an int literal.
+            lexChunk(i, state);
         }
-        if (not std::isalnum(c)) break;
-    }
-    if (not seenDot) return std::nullopt;
 
-    // Incrementation & return.
-    std::string_view content = fixedView.substr(0, i);
-    view.remove_prefix(content.size());
-    return Lexer::Token(Lexer::Tag::FLOAT_LITERAL, content);
+        this->m_tokens.append(chunk.tokens);
+        this->m_errors.insert(this->m_errors.end(), chunk.errors.begin(), chunk.errors.end());
+        this->m_stats.merge(chunk.stats);
+        state = std::move(chunk.end);
+    }
 }
-std::optional<Lexer::Token> Lexer::Generator::extractIntLiteral(std::string_view& view)
+std::size_t Lexer::Generator::findChunkStart(std::size_t offset) const
 {
-    // Forced Code.
-    std::string_view fixedView;
-    if (auto opt = Lexer::Generator::extractUntilNewLine(view)) fixedView = opt.value();
-    else return std::nullopt;
+    // The first line after offset that starts with no indention (And isn't empty, a comment or a closing ) or ]).
+    // The line before it must not end with a comment, spaces, triple quotes or an open list, those usually make the guess wrong.
+    for (std::size_t index = this->m_lines.indexOf(offset) + 1; index < this->m_lines.size(); index++)
+    {
+        std::size_t start = this->m_lines.start(index);
+        if (start >= this->m_file.size()) break;
 
-    // Early return.
-    if (not std::isdigit(static_cast<unsigned char>(fixedView.front()))) return std::nullopt;
+        char first = this->m_file[start];
+        if (first == ' ' or first == '\t' or first == '\n' or first == '#' or first == ')' or first == ']') continue;
 
-    // Scan.
-    std::size_t i = 0;
-    for (i = 0; i < fixedView.size(); i++)
-    {
-        unsigned char c = static_cast<unsigned char>(fixedView[i]);
+        std::string_view previous = this->m_file.substr(this->m_lines.start(index - 1), this->m_lines.end(index - 1) - this->m_lines.start(index - 1));
+        if (previous.ends_with(' ') or previous.ends_with('\t') or previous.ends_with('(') or previous.ends_with('[') or previous.ends_with(',')) continue;
+        if (previous.find('#') != std::string_view::npos or previous.find("\"\"\"") != std::string_view::npos) continue;
 
-        if (std::isalpha(c)) throw Lexer::Generator::Error("Invalid integer literal", i);
-        if (not std::isalnum(c)) break;
+        return start;
     }
+    return this->m_file.size();
+}
 
-    // Incrementation & return.
-    std::string_view content = fixedView.substr(0, i);
-    view.remove_prefix(content.size());
-    return Lexer::Token(Lexer::Tag::INT_LITERAL, content);
+bool Lexer::Generator::empty(void) const
+{
+    return this->m_tokens.empty();
 }
-std::optional<Lexer::Token> Lexer::Generator::extractBoolLiteral(std::string_view& view)
+std::size_t Lexer::Generator::size(void) const
 {
-    // Forced Code.
-    std::string_view fixedView;
-    if (auto opt = Lexer::Generator::extractUntilNewLine(view)) fixedView = opt.value();
-    else return std::nullopt;
-
-    // Early return.
-    std::string_view possibleNone;
-    if (auto opt = Lexer::Generator::extractUntilNotAlnum(fixedView)) possibleNone = opt.value();
-    else return std::nullopt;
-
-    // Scan.
-    if (possibleNone == "True" or possibleNone == "False")
-    {
-        /// Incrementation & return.
-        std::string_view content = possibleNone;
-        view.remove_prefix(content.size());
-        return Lexer::Token(Lexer::Tag::BOOL_LITERAL, content);
-    }
-
-    // Return default.
-    return std::nullopt;
+    return this->m_tokens.size();
 }
-std::optional<Lexer::Token> Lexer::Generator::extractNoneLiteral(std::string_view& view)
+Lexer::Token Lexer::Generator::operator [] (std::size_t index) const
 {
-    // Forced Code.
-    std::string_view fixedView;
-    if (auto opt = Lexer::Generator::extractUntilNewLine(view)) fixedView = opt.value();
-    else return std::nullopt;
-
-    // Early return.
-    std::string_view possibleNone;
-    if (auto opt = Lexer::Generator::extractUntilNotAlnum(fixedView)) possibleNone = opt.value();
-    else return std::nullopt;
-
-    // Scan.
-    if (possibleNone == "None")
-    {
-        // Incrementation & return.
-        std::string_view content = possibleNone;
-        view.remove_prefix(content.size());
-        return Lexer::Token(Lexer::Tag::NONE_LITERAL, content);
-    }
-
-    // Return default.
-    return std::nullopt;
+    return this->m_tokens[index];
 }
-std::optional<Lexer::Token> Lexer::Generator::extractSymbol(std::string_view& view, std::size_t& depthClosingCount)
+Lexer::TokenList::Iterator Lexer::Generator::begin(void) const
 {
-    // Forced Code.
-    std::string_view fixedView;
-    if (auto opt = Lexer::Generator::extractUntilNewLine(view)) fixedView = opt.value();
-    else return std::nullopt;
-
-    // Data.
-    static constexpr auto wordSymbols = std::to_array<std::string_view>(
-    {
-        "and", "or", "not", "is", "as"
-    });
-    static constexpr auto punctuator3Symbols = std::to_array<std::string_view>(
-    {
-        "<<=", ">>=", "..."
-    });
-    static constexpr auto punctuator2Symbols = std::to_array<std::string_view>(
-    {
-        "++", "+=", "--", "-=", "*=", "/=", "%=", ">=", "<=", ">>", "<<", "|=", "&=", "^=", "==", "!=", "->", "::"
-    });
-    static constexpr auto punctuator1symbols = std::to_array<char>(
-    {
-        '+', '-', '*', '/', '%', '<', '>', '|', '&', '^', '~', '=', '.', ',', '(', ')', '[', ']', '?', ':'
-    });
-
-    // Scan 1.
-    std::string_view possibleWordSymbol;
-    if (auto opt = Lexer::Generator::extractUntilNotAlnum(fixedView))
-    {
-        possibleWordSymbol = opt.value();
-        for (auto& wordSymbol : wordSymbols)
-        {
-            if (possibleWordSymbol == wordSymbol)
-            {
-                // Incrementation & return.
-                std::string_view content = possibleWordSymbol;
-                view.remove_prefix(content.size());
-                return Token(Lexer::Tag::SYMBOL, content);
-            }
-        }
-        return std::nullopt;
-    }
-    // Scan 2.
-    for (auto& punctuator3Symbol : punctuator3Symbols)
-    {
-        if (fixedView.starts_with(punctuator3Symbol))
-        {
-            constexpr std::size_t OFFSET = 3;
-
-            // Incrementation & return.
-            std::string_view content = fixedView.substr(0, OFFSET);
-            view.remove_prefix(OFFSET);
-            return Token(Lexer::Tag::SYMBOL, content);
-        }
-    }
-    // Scan 3.
-    for (auto& punctuator2Symbol : punctuator2Symbols)
-    {
-        if (fixedView.starts_with(punctuator2Symbol))
-        {
-            constexpr std::size_t OFFSET = 2;
-
-            // Incrementation & return.
-            std::string_view content = fixedView.substr(0, OFFSET);
-            view.remove_prefix(OFFSET);
-            return Token(Lexer::Tag::SYMBOL, content);
-        }
-    }
-    // Scan 4.
-    for (char punctuator1Symbol : punctuator1symbols)
-    {
-        if (fixedView.starts_with(punctuator1Symbol))
-        {
-            if (punctuator1Symbol == '(' or punctuator1Symbol == '[')
-            {
-                depthClosingCount++;
-            }
-            else if (punctuator1Symbol == ')' or punctuator1Symbol == ']')
-            {
-                if (depthClosingCount > 0) depthClosingCount--;
-            }
-
-            constexpr std::size_t OFFSET = 1;
-
-            // Incrementation & return.
-            std::string_view content = fixedView.substr(0, OFFSET);
-            view.remove_prefix(OFFSET);
-            return Token(Lexer::Tag::SYMBOL, content);
-        }
-    }
-
-    // Return default.
-    return std::nullopt;
+    return this->m_tokens.begin();
 }
-std::optional<Lexer::Token> Lexer::Generator::extractKeyword(std::string_view& view)
+Lexer::TokenList::Iterator Lexer::Generator::end(void) const
 {
-    // Forced code.
-    std::string_view fixedView;
-    if (auto opt = Lexer::Generator::extractUntilNewLine(view)) fixedView = opt.value();
-    else return std::nullopt;
-
-    // Data.
-    static constexpr auto keywords = std::to_array<std::string_view>(
-    {
-        "if", "elif", "else",
-        "for", "while", "switch", "case", "default",
-        "break", "continue",
-        "label", "goto",
-        "def", "return", "class",
-        "const", "static",
-        "int8", "uint8",
-        "int16", "uint16",
-        "int32", "uint32",
-        "int64", "uint64",
-        "float", "double",
-        "import",
-        "ptr", "ref", "dref", "arr",
-        "enum", "namespace", "typedef"
-    });
-
-    // Early return.
-    std::string_view possibleKeyword;
-    if (auto opt = Lexer::Generator::extractUntilNotAlnum(fixedView)) possibleKeyword = opt.value();
-    else return std::nullopt;
-
-    // Scan.
-    for (std::size_t i = 0; i < keywords.size(); i++)
-    {
-        if (keywords[i] == possibleKeyword)
-        {
-            // Incrementation & return.
-            view.remove_prefix(possibleKeyword.size());
-            return Token(Lexer::Tag::KEYWORD, possibleKeyword);
-        }
-    }
-
-    // Return default.
-    return std::nullopt;
+    return this->m_tokens.end();
 }
-std::optional<Lexer::Token> Lexer::Generator::extractNewLine(std::string_view& view)
+const Lexer::TokenList& Lexer::Generator::tokens(void) const
 {
-    // Scan.
-    if (view.front() == '\n')
-    {
-        // Incrementation & return.
-        view.remove_prefix(std::strlen("\n"));
-        return Lexer::Token(Lexer::Tag::NEW_LINE);
-    }
-
-    return std::nullopt;
+    return this->m_tokens;
 }
-std::optional<std::vector<Lexer::Token>> Lexer::Generator::extractInDedent(std::string_view& view, std::stack<std::size_t>& identLevels)
+std::string_view Lexer::Generator::source(void) const
 {
-    // Early return.
-    std::size_t newLevel;
-    if (auto opt = Lexer::Generator::extractSpacesLevel(view)) newLevel = opt.value();
-    else return std::nullopt;
-    if (identLevels.empty() and newLevel == 0)
-    {
-        return std::nullopt;
-    }
-
-    // Scan 1.
-    if (identLevels.empty() or newLevel > identLevels.top()) 
-    {
-        identLevels.push(newLevel);
-        return std::vector<Lexer::Token>{ Lexer::Token(Lexer::Tag::INDENT) };
-    }
-    else if (identLevels.top() == newLevel)
-    {
-        return std::nullopt;
-    }
-
-    // Scan 2.
-    std::vector<Lexer::Token> dedents;
-    while (not identLevels.empty() and identLevels.top() > newLevel) 
-    {
-        identLevels.pop();
-        dedents.emplace_back(Lexer::Tag::DEDENT);
-    }
-    if ((identLevels.empty() or identLevels.top() != newLevel) and newLevel != 0) throw Lexer::Generator::Error("Indent (spacing) doesn't match previous indents", std::string_view::npos);
+    return this->m_file;
+}
 
-    // Return.
-    return dedents;
+bool Lexer::Generator::didPass(void) const
+{
+    return this->m_errors.empty();
 }
-std::optional<Lexer::Token> Lexer::Generator::extractIdentifier(std::string_view& view)
+const std::vector<Lexer::Diagnostic>& Lexer::Generator::errors(void) const
 {
-    // Forced code.
-    std::string_view fixedView;
-    if (auto opt = Lexer::Generator::extractUntilNewLine(view)) fixedView = opt.value();
-    else return std::nullopt;
-
-    // Early return/errors.
-    if (fixedView.front() == '#') return std::nullopt;
-    if (not std::isalnum(static_cast<unsigned char>(fixedView.front())) and fixedView.front() != '_') throw Lexer::Generator::Error("Invalid character");
+    return this->m_errors;
+}
 
-    // Extraction.
-    std::string_view content;
-    if (auto opt = Lexer::Generator::extractUntilNotAlnum(fixedView)) content = opt.value();
-    else return std::nullopt;
+const Lexer::LineTable& Lexer::Generator::lines(void) const
+{
+    return this->m_lines;
+}
 
-    // Incrementation & return.
-    view.remove_prefix(content.size());
-    return Lexer::Token(Lexer::Tag::IDENTIFIER, content);
+const Lexer::Stats& Lexer::Generator::stats(void) const
+{
+    return this->m_stats;
+}
+bool Lexer::Generator::isCacheHit(void) const
+{
+    return this->m_isCacheHit;
 }
 
 std::ostream& Lexer::operator << (std::ostream& stream, const Lexer::Generator& generator)
 {
-    std::copy(generator.begin(), generator.end(), std::ostream_iterator<Lexer::Token>(stream));
+    // One buffer and big writes instead of a stream call for every piece of every token (See Lexer::Writer).
+    Lexer::Writer writer(stream);
+    writer.write(generator.m_tokens);
 
     if (not generator.didPass())
     {
-        stream << "\nAt file: " << generator.m_filename << "\n\n";
-        std::copy(generator.m_errors.begin(), generator.m_errors.end(), std::ostream_iterator<std::string>(stream, "\n"));
+        writer.write("\nAt file: ");
+        writer.write(generator.m_filename);
+        writer.write("\n\n");
+        for (const Lexer::Diagnostic& error : generator.m_errors)
+        {
+            writer.write(error.toString()); // Only formatted here.
+            writer.write("\n");
+        }
     }
 
     return stream;
 }
-
-Lexer::Generator::Error::Error(const char* new_error, std::size_t new_column)
-    : error(new_error), column(new_column)
-{
-}
@@ -1,64 +1,76 @@
 #pragma once
 #include "../Lexer/Token.hpp"
+#include "../Lexer/TokenList.hpp"
+#include "../Lexer/LineTable.hpp"
+#include "../Lexer/Diagnostic.hpp"
+#include "../Lexer/Stats.hpp"
+#include "../Lexer/Interner.hpp"
+#include "../Lexer/Cache.hpp"
+#include "../Lexer/TokenStream.hpp"
+#include "../Helper/SourceFile.hpp"
 
 #include <vector>
 #include <string_view>
-#include <stack>
+#include <string>
 #include <optional>
+#include <memory_resource>
 
 namespace Lexer
 {
 	class Generator
 	{
 	public:
-		Generator(const char* filename);
+		// With more than 1 thread big files are lexed in parallel chunks.
+		// With an interner every name token gets its ID from it (See Lexer::Token::id). It can be shared with other Generators.
+		// With a cache a source that was already lexed is read from it, and a new one is stored in it (See Lexer::Cache).
+		// With shouldDecodeLiterals numbers get their value (See Lexer::Scanner::decodeLiterals). Streams don't keep those, so the cache is not used.
+		// The tokens and lines are allocated from resource, which must outlive the Generator. It's only used from this thread.
+		Generator(const char* filename, std::size_t threadCount = 1, Lexer::Interner* interner = nullptr, Lexer::Cache* cache = nullptr, bool shouldDecodeLiterals = false,
+			std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+		// A source that is already in memory. name is only for the errors and must outlive the Generator.
+		Generator(Helper::SourceFile&& source, const char* name, std::size_t threadCount = 1, Lexer::Interner* interner = nullptr, Lexer::Cache* cache = nullptr,
+			bool shouldDecodeLiterals = false, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
 		bool empty(void) const;
 		std::size_t size(void) const;
-		const Lexer::Token& operator [] (std::size_t index) const;
-		std::vector<Lexer::Token>::const_iterator begin(void) const;
-		std::vector<Lexer::Token>::const_iterator end(void) const;
+		Lexer::Token operator [] (std::size_t index) const;
+		Lexer::TokenList::Iterator begin(void) const;
+		Lexer::TokenList::Iterator end(void) const;
+		const Lexer::TokenList& tokens(void) const;
+		std::string_view source(void) const; // What the tokens point into.
 
 		friend std::ostream& operator << (std::ostream& stream, const Lexer::Generator& generator);
 
 		bool didPass(void) const;
+		const std::vector<Lexer::Diagnostic>& errors(void) const; // Formatted only when printed (See Lexer::Diagnostic::toString).
 
-	private:
-		struct Error
-		{
-			Error(const char* new_error, std::size_t new_column = 0);
+		const Lexer::LineTable& lines(void) const;
+
+		const Lexer::Stats& stats(void) const; // All 0 without MONOLITH_STATS (See Lexer::Stats), or on a cache hit.
+		bool isCacheHit(void) const;
 
-			const char* const error;
-			const std::size_t column;
-		};
+	private:
+		// std::nullopt if the file could not be opened.
+		Generator(std::optional<Helper::SourceFile>&& source, const char* filename, std::size_t threadCount, Lexer::Interner* interner, Lexer::Cache* cache,
+			bool shouldDecodeLiterals, std::pmr::memory_resource* resource);
 
-		static void skipSpaces(std::string_view& view);
-		static void incrementToNextLine(std::string_view& view);
+		void lexSerial(void);
+		void lexParallel(std::size_t threadCount);
+		std::size_t findChunkStart(std::size_t offset) const;
 
-		static std::optional<std::size_t> extractSpacesLevel(const std::string_view& view);
-		static std::optional<std::string_view> extractUntilNewLine(const std::string_view& view);
-		static std::optional<std::string_view> extractUntilNotAlnum(const std::string_view& view);
-		
-		static std::optional<Lexer::Token> extractString3Literal(std::string_view& view);
-		static std::optional<Lexer::Token> extractStringLiteral(std::string_view& view);
-		static std::optional<Lexer::Token> extractCharLiteral(std::string_view& view);
-		static std::optional<Lexer::Token> extractHexLiteral(std::string_view& view);
-		static std::optional<Lexer::Token> extractBinLiteral(std::string_view& view);
-		static std::optional<Lexer::Token> extractOctLiteral(std::string_view& view);
-		static std::optional<Lexer::Token> extractSciLiteral(std::string_view& view);
-		static std::optional<Lexer::Token> extractFloatLiteral(std::string_view& view);
-		static std::optional<Lexer::Token> extractIntLiteral(std::string_view& view);
-		static std::optional<Lexer::Token> extractBoolLiteral(std::string_view& view);
-		static std::optional<Lexer::Token> extractNoneLiteral(std::string_view& view);
-		static std::optional<Lexer::Token> extractSymbol(std::string_view& view, std::size_t& skipIndentFlag);
-		static std::optional<Lexer::Token> extractKeyword(std::string_view& view);
-		static std::optional<Lexer::Token> extractNewLine(std::string_view& view);
-		static std::optional<std::vector<Lexer::Token>> extractInDedent(std::string_view& view, std::stack<std::size_t>& identLevels);
-		static std::optional<Lexer::Token> extractIdentifier(std::string_view& view);
+		static constexpr std::size_t minChunkSize = 1 << 20; // Smaller chunks are not worth a thread.
+		// For reserving the tokens up front. Dense code is about 3.4 bytes a token, so it rarely grows.
+		// Too many only costs address space, the pages that are never written are never touched.
+		static constexpr std::size_t minBytesPerToken = 3;
 
 		const char* m_filename;
-		std::string m_file; // Life of the string cannot be in the constructor but in the class itself.
-		std::vector<Lexer::Token> m_tokens;
-		std::vector<std::string> m_errors;
+		Helper::SourceFile m_source; // Life of the content cannot be in the constructor but in the class itself.
+		std::string_view m_file; // All of m_source. Tokens point straight into it.
+		Lexer::TokenList m_tokens;
+		std::vector<Lexer::Diagnostic> m_errors;
+		Lexer::LineTable m_lines;
+		Lexer::Stats m_stats;
+		bool m_isCacheHit; // Then the tokens keep the mapped entry, and the errors point into it.
+		bool m_shouldDecodeLiterals;
 	};
 }
@@ -0,0 +1,110 @@
+#include "../Lexer/Interner.hpp"
+#include "../Helper/Assert.hpp"
+#include <algorithm>
+#include <cstring>
+
+Lexer::Interner::Interner(void) : m_slots(Lexer::Interner::initialCapacity, Slot{ 0, Lexer::Token::noId }), m_blockUsed(Lexer::Interner::blockSize)
+{
+}
+
+std::uint32_t Lexer::Interner::intern(const std::string_view& name)
+{
+    std::lock_guard lock(this->m_mutex);
+    return this->find(name);
+}
+std::pmr::vector<std::uint32_t> Lexer::Interner::intern(const Lexer::TokenList& tokens)
+{
+    std::pmr::vector<std::uint32_t> ids(tokens.size(), Lexer::Token::noId, tokens.resource());
+    std::span<const Lexer::Tag> tags = tokens.tags();
+
+    std::lock_guard lock(this->m_mutex);
+    for (std::size_t i = 0; i < tokens.size(); i++)
+    {
+        if (Lexer::Interner::isName(tags[i])) ids[i] = this->find(tokens[i].content);
+    }
+    return ids;
+}
+
+std::string_view Lexer::Interner::name(std::uint32_t id) const
+{
+    std::lock_guard lock(this->m_mutex);
+    Assert_Message(id < this->m_names.size(), std::format("Unknown name ID: {}", id));
+    return this->m_names[id];
+}
+std::size_t Lexer::Interner::size(void) const
+{
+    std::lock_guard lock(this->m_mutex);
+    return this->m_names.size();
+}
+
+bool Lexer::Interner::isName(Lexer::Tag tag)
+{
+    return tag == Lexer::Tag::IDENTIFIER or tag == Lexer::Tag::KEYWORD;
+}
+
+std::uint32_t Lexer::Interner::find(const std::string_view& name)
+{
+    std::uint32_t hash = Lexer::Interner::hash(name);
+    std::size_t mask = this->m_slots.size() - 1;
+    for (std::size_t index = hash & mask;; index = (index + 1) & mask)
+    {
+        Slot& slot = this->m_slots[index];
+        if (slot.id == Lexer::Token::noId)
+        {
+            Assert_Message(this->m_names.size() < Lexer::Token::noId, "Too many names");
+
+            slot = Slot{ hash, static_cast<std::uint32_t>(this->m_names.size()) };
+            this->m_names.emplace_back(this->store(name));
+            if (this->m_names.size() * 2 > this->m_slots.size()) this->grow(); // At most half full, so probes stay short.
+            return static_cast<std::uint32_t>(this->m_names.size() - 1);
+        }
+        if (slot.hash == hash and this->m_names[slot.id] == name) return slot.id;
+    }
+}
+std::string_view Lexer::Interner::store(const std::string_view& name)
+{
+    if (name.empty()) return {};
+    if (Lexer::Interner::blockSize - this->m_blockUsed < name.size())
+    {
+        std::size_t size = std::max(name.size(), Lexer::Interner::blockSize);
+        this->m_blocks.emplace_back(std::make_unique_for_overwrite<char[]>(size));
+        this->m_blockUsed = 0;
+    }
+    char* data = this->m_blocks.back().get() + this->m_blockUsed;
+    std::memcpy(data, name.data(), name.size());
+    this->m_blockUsed = std::min(this->m_blockUsed + name.size(), Lexer::Interner::blockSize); // A block of a long name is full right away.
+    return std::string_view(data, name.size());
+}
+void Lexer::Interner::grow(void)
+{
+    std::vector<Slot> slots(this->m_slots.size() * 2, Slot{ 0, Lexer::Token::noId });
+    std::size_t mask = slots.size() - 1;
+    for (const Slot& slot : this->m_slots)
+    {
+        if (slot.id == Lexer::Token::noId) continue;
+
+        std::size_t index = slot.hash & mask;
+        while (slots[index].id != Lexer::Token::noId) index = (index + 1) & mask;
+        slots[index] = slot;
+    }
+    this->m_slots = std::move(slots);
+}
+
+std::uint32_t Lexer::Interner::hash(const std::string_view& name)
+{
+    // 8 bytes at a time, most names are one or two steps.
+    std::uint64_t hash = name.size() * 0x9E3779B97F4A7C15;
+    const char* data = name.data();
+    std::size_t size = name.size();
+    while (true)
+    {
+        std::uint64_t word = 0;
+        std::memcpy(&word, data, std::min<std::size_t>(size, 8));
+        hash = (hash ^ word) * 0xBF58476D1CE4E5B9;
+        hash ^= hash >> 31;
+        if (size <= 8) break;
+        data += 8;
+        size -= 8;
+    }
+    return static_cast<std::uint32_t>(hash >> 32);
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include "../Lexer/TokenList.hpp"
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+
+namespace Lexer
+{
+	// Gives every distinct name (IDENTIFIER and KEYWORD content) a dense 32-bit ID: 0, 1, 2... in the order they are first seen.
+	// Later stages compare and hash IDs instead of strings. One Interner can be shared by many Generators (And threads),
+	// then the same name has the same ID in all of their tokens (See Driver::Batch).
+	// The names are copied into the Interner, so they outlive the sources they came from.
+	class Interner
+	{
+	public:
+		Interner(void);
+		Interner(const Lexer::Interner&) = delete;
+		Lexer::Interner& operator = (const Lexer::Interner&) = delete;
+
+		std::uint32_t intern(const std::string_view& name);
+		// An ID for every token, Lexer::Token::noId if it's not a name. Locks once. Allocated from the resource of tokens.
+		std::pmr::vector<std::uint32_t> intern(const Lexer::TokenList& tokens);
+
+		std::string_view name(std::uint32_t id) const;
+		std::size_t size(void) const;
+
+		static bool isName(Lexer::Tag tag);
+
+	private:
+		// Open addressing with linear probing. A slot is 8 bytes and keeps the hash, so a probe only compares
+		// the name when the hashes are the same, and growing never hashes a name again.
+		struct Slot
+		{
+			std::uint32_t hash;
+			std::uint32_t id; // Lexer::Token::noId when empty.
+		};
+
+		std::uint32_t find(const std::string_view& name); // m_mutex must be locked.
+		std::string_view store(const std::string_view& name); // Copies name into the arena.
+		void grow(void);
+
+		static std::uint32_t hash(const std::string_view& name);
+
+		static constexpr std::size_t initialCapacity = 1 << 10; // Slots. Always a power of 2.
+		static constexpr std::size_t blockSize = 1 << 16; // Bytes of an arena block. Longer names get their own block.
+
+		mutable std::mutex m_mutex;
+		std::vector<Slot> m_slots;
+		std::vector<std::string_view> m_names; // By ID. Point into m_blocks, which never move.
+		std::vector<std::unique_ptr<char[]>> m_blocks;
+		std::size_t m_blockUsed; // Bytes used of m_blocks.back().
+	};
+}
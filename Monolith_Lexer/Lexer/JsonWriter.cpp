@@ -0,0 +1,152 @@
+#include "../Lexer/JsonWriter.hpp"
+#include "../Lexer/Generator.hpp"
+#include "../Helper/Simd.hpp"
+#include "../Helper/Assert.hpp"
+#include <array>
+#include <charconv>
+
+namespace
+{
+    constexpr std::size_t tagsCount = static_cast<std::size_t>(Lexer::Tag::IDENTIFIER) + 1;
+
+    // The start of the object of every Tag.
+    constexpr std::array<std::string_view, tagsCount> heads =
+    {
+        "{\"tag\":\"STRING3_LITERAL\"",
+        "{\"tag\":\"STRING_LITERAL\"",
+        "{\"tag\":\"CHAR_LITERAL\"",
+        "{\"tag\":\"HEX_LITERAL\"",
+        "{\"tag\":\"BIN_LITERAL\"",
+        "{\"tag\":\"OCT_LITERAL\"",
+        "{\"tag\":\"SCI_LITERAL\"",
+        "{\"tag\":\"FLOAT_LITERAL\"",
+        "{\"tag\":\"INT_LITERAL\"",
+        "{\"tag\":\"BOOL_LITERAL\"",
+        "{\"tag\":\"NONE_LITERAL\"",
+        "{\"tag\":\"SYMBOL\"",
+        "{\"tag\":\"KEYWORD\"",
+        "{\"tag\":\"NEW_LINE\"",
+        "{\"tag\":\"INDENT\"",
+        "{\"tag\":\"DEDENT\"",
+        "{\"tag\":\"IDENTIFIER\"",
+    };
+}
+
+Lexer::JsonWriter::JsonWriter(std::ostream& stream) : m_buffer(stream)
+{
+}
+
+void Lexer::JsonWriter::write(const Lexer::Generator& generator)
+{
+    this->write(generator.tokens(), generator.lines());
+    for (const Lexer::Diagnostic& error : generator.errors())
+    {
+        this->write(error);
+    }
+}
+void Lexer::JsonWriter::write(const Lexer::TokenList& tokens, const Lexer::LineTable& lines)
+{
+    // Tokens are in source order, so the line only moves forward (No search for every token).
+    const char* source = tokens.source();
+    std::size_t line = 0;
+    for (std::size_t i = 0; i < tokens.size(); i++)
+    {
+        Lexer::Tag tag = tokens.tags()[i];
+        Assert_Message(static_cast<std::size_t>(tag) < tagsCount, std::format("Unknown Tag: {}", static_cast<int>(tag)));
+        this->m_buffer.write(heads[static_cast<std::size_t>(tag)]);
+
+        std::uint32_t offset = tokens.offsets()[i];
+        std::uint32_t length = tokens.lengths()[i];
+        while (line + 1 < lines.size() and lines.start(line + 1) <= offset) line++;
+
+        if (length)
+        {
+            this->m_buffer.write(",\"content\":");
+            this->writeString(std::string_view(source + offset, length));
+        }
+        this->m_buffer.write(",\"offset\":");
+        this->writeNumber(offset);
+        this->m_buffer.write(",\"line\":");
+        this->writeNumber(line + 1);
+        this->m_buffer.write(",\"column\":");
+        this->writeNumber(offset - lines.start(line));
+        if (tokens.hasLiterals() and Lexer::Literal::isNumber(tag))
+        {
+            this->m_buffer.write(",\"value\":");
+            if (Lexer::Literal::isReal(tag)) this->writeReal(tokens.literals()[i].real);
+            else this->writeNumber(tokens.literals()[i].integer);
+        }
+        if (tokens.isInterned() and tokens.ids()[i] != Lexer::Token::noId)
+        {
+            this->m_buffer.write(",\"id\":");
+            this->writeNumber(tokens.ids()[i]);
+        }
+        this->m_buffer.write("}\n");
+    }
+}
+void Lexer::JsonWriter::write(const Lexer::Diagnostic& error)
+{
+    this->m_buffer.write("{\"error\":");
+    this->writeString(error.error);
+    if (error.line)
+    {
+        this->m_buffer.write(",\"line\":");
+        this->writeNumber(error.line);
+    }
+    if (not error.code.empty())
+    {
+        this->m_buffer.write(",\"code\":");
+        this->writeString(error.code);
+    }
+    if (error.line)
+    {
+        this->m_buffer.write(",\"codeColumn\":");
+        this->writeNumber(error.column);
+    }
+    this->m_buffer.write("}\n");
+}
+void Lexer::JsonWriter::flush(void)
+{
+    this->m_buffer.flush();
+}
+
+void Lexer::JsonWriter::writeString(std::string_view text)
+{
+    constexpr char hex[] = "0123456789abcdef";
+
+    this->m_buffer.write('"');
+    while (true)
+    {
+        // Copy the run that needs no escaping as is, then escape one char.
+        std::size_t run = Helper::Simd::findJsonEscape(text);
+        this->m_buffer.write(text.substr(0, run));
+        if (run == text.size()) break;
+
+        char c = text[run];
+        switch (c)
+        {
+        case '"': this->m_buffer.write("\\\""); break;
+        case '\\': this->m_buffer.write("\\\\"); break;
+        case '\n': this->m_buffer.write("\\n"); break;
+        case '\t': this->m_buffer.write("\\t"); break;
+        case '\r': this->m_buffer.write("\\r"); break;
+
+        default:
+            char escaped[] = { '\\', 'u', '0', '0', hex[(c >> 4) & 0xF], hex[c & 0xF] };
+            this->m_buffer.write(std::string_view(escaped, sizeof(escaped)));
+        }
+        text.remove_prefix(run + 1);
+    }
+    this->m_buffer.write('"');
+}
+void Lexer::JsonWriter::writeNumber(std::uint64_t number)
+{
+    char* out = this->m_buffer.reserve(20); // The most digits of a std::uint64_t.
+    this->m_buffer.commit(std::to_chars(out, out + 20, number).ptr - out);
+}
+void Lexer::JsonWriter::writeReal(double number)
+{
+    // The shortest text that reads back the same double. Literals are never inf or nan (Those are errors).
+    char* out = this->m_buffer.reserve(24); // The longest one, like -2.2250738585072014e-308.
+    this->m_buffer.commit(std::to_chars(out, out + 24, number).ptr - out);
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include "../Lexer/TokenList.hpp"
+#include "../Lexer/LineTable.hpp"
+#include "../Lexer/Diagnostic.hpp"
+#include "../Helper/OutputBuffer.hpp"
+
+#include <string_view>
+#include <ostream>
+#include <cstdint>
+
+namespace Lexer
+{
+	class Generator;
+
+	// Writes tokens and errors as JSON Lines (One object a line) for tools, straight into a buffer (See Helper::OutputBuffer).
+	// Nothing is built in memory first, and text is escaped in runs found by Helper::Simd::findJsonEscape, so it's linear even for huge literals.
+	//
+	// {"tag":"IDENTIFIER","content":"x","offset":12,"line":3,"column":4}
+	//     offset is into the source, line starts at 1 (Like the errors) and column at 0 (In bytes). Every token has all three.
+	//     Tokens without content (NEW_LINE, INDENT and DEDENT) have no "content": {"tag":"NEW_LINE","offset":13,"line":3,"column":5}.
+	// {"tag":"HEX_LITERAL","content":"0x1F","offset":20,"line":4,"column":4,"value":31}
+	//     Numbers have "value" when literals were decoded (See Lexer::Scanner::decodeLiterals), a JSON number for integers and floats alike.
+	//     Interned tokens also have "id" (See Lexer::Interner), after "value".
+	// {"error":"Invalid number","line":3,"code":"x = 0b102","codeColumn":8}
+	//     code and codeColumn are like in Lexer::Diagnostic. An error about the whole source has no line and codeColumn.
+	class JsonWriter
+	{
+	public:
+		JsonWriter(std::ostream& stream);
+
+		void write(const Lexer::Generator& generator); // The tokens and then the errors.
+		void write(const Lexer::TokenList& tokens, const Lexer::LineTable& lines); // lines must be of the source of tokens.
+		void write(const Lexer::Diagnostic& error);
+		void flush(void);
+
+	private:
+		void writeString(std::string_view text); // Quoted and escaped.
+		void writeNumber(std::uint64_t number);
+		void writeReal(double number);
+
+		Helper::OutputBuffer m_buffer;
+	};
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <cstdint>
+
+namespace Lexer
+{
+	// Which symbol or keyword a token is, so a parser can switch on it instead of comparing content.
+	// Set by the lexer from the same tables it matches with (See Lexer::Punctuator and Lexer::ReservedWord), NONE for every other token.
+	enum class Kind : std::uint8_t // 1 byte, so it packs tightly (See Lexer::TokenList).
+	{
+		NONE,
+
+		// Symbols
+		SHIFT_LEFT_ASSIGN,  // <<=
+		SHIFT_RIGHT_ASSIGN, // >>=
+		ELLIPSIS,           // ...
+		INCREMENT,          // ++
+		PLUS_ASSIGN,        // +=
+		DECREMENT,          // --
+		MINUS_ASSIGN,       // -=
+		STAR_ASSIGN,        // *=
+		SLASH_ASSIGN,       // /=
+		PERCENT_ASSIGN,     // %=
+		GREATER_EQUAL,      // >=
+		LESS_EQUAL,         // <=
+		SHIFT_RIGHT,        // >>
+		SHIFT_LEFT,         // <<
+		PIPE_ASSIGN,        // |=
+		AMPERSAND_ASSIGN,   // &=
+		CARET_ASSIGN,       // ^=
+		EQUAL,              // ==
+		NOT_EQUAL,          // !=
+		ARROW,              // ->
+		SCOPE,              // ::
+		PLUS,               // +
+		MINUS,              // -
+		STAR,               // *
+		SLASH,              // /
+		PERCENT,            // %
+		LESS,               // <
+		GREATER,            // >
+		PIPE,               // |
+		AMPERSAND,          // &
+		CARET,              // ^
+		TILDE,              // ~
+		ASSIGN,             // =
+		DOT,                // .
+		COMMA,              // ,
+		LEFT_PAREN,         // (
+		RIGHT_PAREN,        // )
+		LEFT_BRACKET,       // [
+		RIGHT_BRACKET,      // ]
+		QUESTION,           // ?
+		COLON,              // :
+		AND,                // and
+		OR,                 // or
+		NOT,                // not
+		IS,                 // is
+		AS,                 // as
+
+		// Keywords
+		IF, ELIF, ELSE, FOR, WHILE, SWITCH, CASE, DEFAULT, BREAK, CONTINUE, LABEL, GOTO,
+		DEF, RETURN, CLASS, CONST, STATIC,
+		INT8, UINT8, INT16, UINT16, INT32, UINT32, INT64, UINT64, FLOAT, DOUBLE,
+		IMPORT, PTR, REF, DREF, ARR, ENUM, NAMESPACE, TYPEDEF,
+	};
+}
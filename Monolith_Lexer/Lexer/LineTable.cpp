@@ -0,0 +1,35 @@
+#include "../Lexer/LineTable.hpp"
+#include "../Helper/Simd.hpp"
+#include <algorithm>
+
+Lexer::LineTable::LineTable(const std::string_view& source, std::pmr::memory_resource* resource) : m_starts(resource), m_sourceSize(source.size())
+{
+    this->m_starts.emplace_back(0);
+    for (std::size_t pos = Helper::Simd::findNewLine(source); pos < source.size(); pos += Helper::Simd::findNewLine(source.substr(pos + 1)) + 1)
+    {
+        this->m_starts.emplace_back(pos + 1);
+    }
+}
+
+std::size_t Lexer::LineTable::size(void) const
+{
+    return this->m_starts.size();
+}
+std::size_t Lexer::LineTable::indexOf(std::size_t offset) const
+{
+    // The first line that starts after the offset is the one after ours.
+    auto it = std::upper_bound(this->m_starts.begin(), this->m_starts.end(), offset);
+    return std::distance(this->m_starts.begin(), it) - 1;
+}
+std::size_t Lexer::LineTable::start(std::size_t index) const
+{
+    return this->m_starts[index];
+}
+std::size_t Lexer::LineTable::end(std::size_t index) const
+{
+    if (index + 1 < this->m_starts.size())
+    {
+        return this->m_starts[index + 1] - 1;
+    }
+    return this->m_sourceSize;
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include <vector>
+#include <memory_resource>
+#include <string_view>
+#include <cstddef>
+
+namespace Lexer
+{
+	// Holds the offset of where every line of a source starts.
+	// It's built once, so the Generator never has to search for a '\n' again.
+	// Tools can use it too (See Lexer::Generator::lines) to turn a byte offset into a line in O(log n).
+	class LineTable
+	{
+	public:
+		LineTable(const std::string_view& source = {}, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+		std::size_t size(void) const; // Number of lines. An empty source still has 1 line.
+		std::size_t indexOf(std::size_t offset) const; // Index (starts at 0) of the line the offset is in.
+		std::size_t start(std::size_t index) const; // Offset of the first char of the line.
+		std::size_t end(std::size_t index) const; // Offset of the '\n' of the line (Or the end of the source for the last line).
+
+	private:
+		std::pmr::vector<std::size_t> m_starts;
+		std::size_t m_sourceSize;
+	};
+}
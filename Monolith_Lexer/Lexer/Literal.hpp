@@ -0,0 +1,26 @@
+#pragma once
+#include "../Lexer/Tag.hpp"
+#include <cstdint>
+
+namespace Lexer
+{
+	// The value of a number token, decoded while it's lexed (See Lexer::Scanner::decodeLiterals).
+	// Which member is used depends on the Tag. A number never has a sign ('-' is a SYMBOL), so integers are unsigned.
+	union Literal
+	{
+		std::uint64_t integer; // INT_LITERAL, HEX_LITERAL, BIN_LITERAL and OCT_LITERAL.
+		double real;           // FLOAT_LITERAL and SCI_LITERAL.
+
+		static constexpr bool isNumber(Lexer::Tag tag);
+		static constexpr bool isReal(Lexer::Tag tag);
+	};
+
+	constexpr bool Lexer::Literal::isNumber(Lexer::Tag tag)
+	{
+		return tag >= Lexer::Tag::HEX_LITERAL and tag <= Lexer::Tag::INT_LITERAL;
+	}
+	constexpr bool Lexer::Literal::isReal(Lexer::Tag tag)
+	{
+		return tag == Lexer::Tag::FLOAT_LITERAL or tag == Lexer::Tag::SCI_LITERAL;
+	}
+}
@@ -0,0 +1,118 @@
+#pragma once
+#include "../Lexer/Kind.hpp"
+#include <array>
+#include <string_view>
+#include <cstdint>
+
+namespace Lexer
+{
+	// Every symbol that is made of punctuation (The word symbols are reserved words, see Lexer::ReservedWord).
+	// A symbol is found by walking a trie one byte at a time and keeping the longest match (See findPunctuator),
+	// so it takes at most 3 lookups instead of comparing it with all of them.
+	struct Punctuator
+	{
+		std::string_view text;
+		Lexer::Kind kind;
+		std::int8_t depth; // +1 for ( and [, -1 for ) and ]. The bracket depth is changed when the symbol is found.
+	};
+
+	inline constexpr auto punctuators = std::to_array<Lexer::Punctuator>(
+	{
+		{ "<<=", Lexer::Kind::SHIFT_LEFT_ASSIGN, 0 }, { ">>=", Lexer::Kind::SHIFT_RIGHT_ASSIGN, 0 }, { "...", Lexer::Kind::ELLIPSIS, 0 },
+
+		{ "++", Lexer::Kind::INCREMENT, 0 }, { "+=", Lexer::Kind::PLUS_ASSIGN, 0 }, { "--", Lexer::Kind::DECREMENT, 0 },
+		{ "-=", Lexer::Kind::MINUS_ASSIGN, 0 }, { "*=", Lexer::Kind::STAR_ASSIGN, 0 }, { "/=", Lexer::Kind::SLASH_ASSIGN, 0 },
+		{ "%=", Lexer::Kind::PERCENT_ASSIGN, 0 }, { ">=", Lexer::Kind::GREATER_EQUAL, 0 }, { "<=", Lexer::Kind::LESS_EQUAL, 0 },
+		{ ">>", Lexer::Kind::SHIFT_RIGHT, 0 }, { "<<", Lexer::Kind::SHIFT_LEFT, 0 }, { "|=", Lexer::Kind::PIPE_ASSIGN, 0 },
+		{ "&=", Lexer::Kind::AMPERSAND_ASSIGN, 0 }, { "^=", Lexer::Kind::CARET_ASSIGN, 0 }, { "==", Lexer::Kind::EQUAL, 0 },
+		{ "!=", Lexer::Kind::NOT_EQUAL, 0 }, { "->", Lexer::Kind::ARROW, 0 }, { "::", Lexer::Kind::SCOPE, 0 },
+
+		{ "+", Lexer::Kind::PLUS, 0 }, { "-", Lexer::Kind::MINUS, 0 }, { "*", Lexer::Kind::STAR, 0 },
+		{ "/", Lexer::Kind::SLASH, 0 }, { "%", Lexer::Kind::PERCENT, 0 }, { "<", Lexer::Kind::LESS, 0 },
+		{ ">", Lexer::Kind::GREATER, 0 }, { "|", Lexer::Kind::PIPE, 0 }, { "&", Lexer::Kind::AMPERSAND, 0 },
+		{ "^", Lexer::Kind::CARET, 0 }, { "~", Lexer::Kind::TILDE, 0 }, { "=", Lexer::Kind::ASSIGN, 0 },
+		{ ".", Lexer::Kind::DOT, 0 }, { ",", Lexer::Kind::COMMA, 0 }, { "(", Lexer::Kind::LEFT_PAREN, 1 },
+		{ ")", Lexer::Kind::RIGHT_PAREN, -1 }, { "[", Lexer::Kind::LEFT_BRACKET, 1 }, { "]", Lexer::Kind::RIGHT_BRACKET, -1 },
+		{ "?", Lexer::Kind::QUESTION, 0 }, { ":", Lexer::Kind::COLON, 0 },
+	});
+
+	// The trie only branches on the bytes that appear in punctuators, so every byte gets a small code first (0 is any other byte).
+	inline constexpr std::size_t punctuatorCodesCount = 32;
+
+	constexpr std::array<std::uint8_t, 256> makePunctuatorCodes(void)
+	{
+		std::array<std::uint8_t, 256> codes{};
+		std::uint8_t count = 0;
+		for (const Lexer::Punctuator& punctuator : Lexer::punctuators)
+		{
+			for (char c : punctuator.text)
+			{
+				std::uint8_t& code = codes[static_cast<unsigned char>(c)];
+				if (not code) code = ++count;
+			}
+		}
+		return count < Lexer::punctuatorCodesCount ? codes : std::array<std::uint8_t, 256>{};
+	}
+
+	inline constexpr std::array<std::uint8_t, 256> punctuatorCodes = Lexer::makePunctuatorCodes();
+	static_assert(Lexer::punctuatorCodes['='], "Too many different punctuation bytes. Raise punctuatorCodesCount");
+
+	// A node is a prefix of a punctuator. Node 0 is the empty prefix.
+	struct PunctuatorNode
+	{
+		std::array<std::uint8_t, Lexer::punctuatorCodesCount> next; // By code. 0 if no punctuator starts with this prefix and the byte.
+		std::uint8_t match; // Index in punctuators + 1 if the prefix is a punctuator itself (0 if not, like "..").
+	};
+
+	inline constexpr std::size_t punctuatorNodesCount = 64;
+
+	constexpr std::array<Lexer::PunctuatorNode, Lexer::punctuatorNodesCount> makePunctuatorNodes(void)
+	{
+		std::array<Lexer::PunctuatorNode, Lexer::punctuatorNodesCount> nodes{};
+		std::size_t count = 1;
+		for (std::size_t i = 0; i < Lexer::punctuators.size(); i++)
+		{
+			std::size_t node = 0;
+			for (char c : Lexer::punctuators[i].text)
+			{
+				std::uint8_t& next = nodes[node].next[Lexer::punctuatorCodes[static_cast<unsigned char>(c)]];
+				if (not next)
+				{
+					if (count == nodes.size()) return {}; // Full. The static_assert below fails.
+					next = static_cast<std::uint8_t>(count++);
+				}
+				node = next;
+			}
+			nodes[node].match = static_cast<std::uint8_t>(i + 1);
+		}
+		return nodes;
+	}
+
+	inline constexpr std::array<Lexer::PunctuatorNode, Lexer::punctuatorNodesCount> punctuatorNodes = Lexer::makePunctuatorNodes();
+
+	// The longest punctuator text starts with. nullptr if none.
+	constexpr const Lexer::Punctuator* findPunctuator(const std::string_view& text)
+	{
+		// Maximal munch: walk as far as the trie goes (3 bytes at most), and keep the last prefix that was a punctuator.
+		std::size_t node = 0;
+		std::uint8_t match = 0;
+		for (char c : text)
+		{
+			node = Lexer::punctuatorNodes[node].next[Lexer::punctuatorCodes[static_cast<unsigned char>(c)]];
+			if (not node) break;
+			if (Lexer::punctuatorNodes[node].match) match = Lexer::punctuatorNodes[node].match;
+		}
+		return match ? &Lexer::punctuators[match - 1] : nullptr;
+	}
+
+	constexpr bool isPunctuatorTriePerfect(void)
+	{
+		for (const Lexer::Punctuator& punctuator : Lexer::punctuators)
+		{
+			const Lexer::Punctuator* found = Lexer::findPunctuator(punctuator.text);
+			if (not found or found->text != punctuator.text) return false;
+		}
+		return true;
+	}
+	static_assert(Lexer::isPunctuatorTriePerfect(), "A punctuator is missing from the trie. Raise punctuatorNodesCount");
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include "../Lexer/Tag.hpp"
+#include "../Lexer/Kind.hpp"
+#include <array>
+#include <string_view>
+#include <cstdint>
+
+namespace Lexer
+{
+	// Every word that is not an identifier: keywords, word symbols (and, or...), True, False and None.
+	// A word is looked up with one hash and one compare (See findReservedWord), instead of comparing it with all of them.
+	struct ReservedWord
+	{
+		std::string_view text;
+		Lexer::Tag tag;
+		Lexer::Kind kind; // NONE for True, False and None.
+	};
+
+	inline constexpr auto reservedWords = std::to_array<Lexer::ReservedWord>(
+	{
+		{ "and", Lexer::Tag::SYMBOL, Lexer::Kind::AND }, { "or", Lexer::Tag::SYMBOL, Lexer::Kind::OR }, { "not", Lexer::Tag::SYMBOL, Lexer::Kind::NOT },
+		{ "is", Lexer::Tag::SYMBOL, Lexer::Kind::IS }, { "as", Lexer::Tag::SYMBOL, Lexer::Kind::AS },
+
+		{ "True", Lexer::Tag::BOOL_LITERAL, Lexer::Kind::NONE }, { "False", Lexer::Tag::BOOL_LITERAL, Lexer::Kind::NONE },
+		{ "None", Lexer::Tag::NONE_LITERAL, Lexer::Kind::NONE },
+
+		{ "if", Lexer::Tag::KEYWORD, Lexer::Kind::IF }, { "elif", Lexer::Tag::KEYWORD, Lexer::Kind::ELIF }, { "else", Lexer::Tag::KEYWORD, Lexer::Kind::ELSE },
+		{ "for", Lexer::Tag::KEYWORD, Lexer::Kind::FOR }, { "while", Lexer::Tag::KEYWORD, Lexer::Kind::WHILE }, { "switch", Lexer::Tag::KEYWORD, Lexer::Kind::SWITCH },
+		{ "case", Lexer::Tag::KEYWORD, Lexer::Kind::CASE }, { "default", Lexer::Tag::KEYWORD, Lexer::Kind::DEFAULT },
+		{ "break", Lexer::Tag::KEYWORD, Lexer::Kind::BREAK }, { "continue", Lexer::Tag::KEYWORD, Lexer::Kind::CONTINUE },
+		{ "label", Lexer::Tag::KEYWORD, Lexer::Kind::LABEL }, { "goto", Lexer::Tag::KEYWORD, Lexer::Kind::GOTO },
+		{ "def", Lexer::Tag::KEYWORD, Lexer::Kind::DEF }, { "return", Lexer::Tag::KEYWORD, Lexer::Kind::RETURN }, { "class", Lexer::Tag::KEYWORD, Lexer::Kind::CLASS },
+		{ "const", Lexer::Tag::KEYWORD, Lexer::Kind::CONST }, { "static", Lexer::Tag::KEYWORD, Lexer::Kind::STATIC },
+		{ "int8", Lexer::Tag::KEYWORD, Lexer::Kind::INT8 }, { "uint8", Lexer::Tag::KEYWORD, Lexer::Kind::UINT8 },
+		{ "int16", Lexer::Tag::KEYWORD, Lexer::Kind::INT16 }, { "uint16", Lexer::Tag::KEYWORD, Lexer::Kind::UINT16 },
+		{ "int32", Lexer::Tag::KEYWORD, Lexer::Kind::INT32 }, { "uint32", Lexer::Tag::KEYWORD, Lexer::Kind::UINT32 },
+		{ "int64", Lexer::Tag::KEYWORD, Lexer::Kind::INT64 }, { "uint64", Lexer::Tag::KEYWORD, Lexer::Kind::UINT64 },
+		{ "float", Lexer::Tag::KEYWORD, Lexer::Kind::FLOAT }, { "double", Lexer::Tag::KEYWORD, Lexer::Kind::DOUBLE },
+		{ "import", Lexer::Tag::KEYWORD, Lexer::Kind::IMPORT },
+		{ "ptr", Lexer::Tag::KEYWORD, Lexer::Kind::PTR }, { "ref", Lexer::Tag::KEYWORD, Lexer::Kind::REF }, { "dref", Lexer::Tag::KEYWORD, Lexer::Kind::DREF }, { "arr", Lexer::Tag::KEYWORD, Lexer::Kind::ARR },
+		{ "enum", Lexer::Tag::KEYWORD, Lexer::Kind::ENUM }, { "namespace", Lexer::Tag::KEYWORD, Lexer::Kind::NAMESPACE }, { "typedef", Lexer::Tag::KEYWORD, Lexer::Kind::TYPEDEF },
+	});
+
+	// Perfect hash: the first two bytes, the last byte and the length packed together and multiplied.
+	// The top 7 bits of the product are the slot. No two reserved words share a slot (Checked below).
+	// If a new word breaks it, find another odd multiplier that passes the static_assert.
+	inline constexpr std::uint32_t reservedWordMultiplier = 334095;
+	inline constexpr std::size_t reservedWordSlotBits = 7;
+
+	constexpr std::size_t reservedWordHash(const std::string_view& word) // word must have at least 2 chars.
+	{
+		std::uint32_t key = static_cast<unsigned char>(word[0])
+			| static_cast<std::uint32_t>(static_cast<unsigned char>(word[1])) << 8
+			| static_cast<std::uint32_t>(static_cast<unsigned char>(word.back())) << 16
+			| static_cast<std::uint32_t>(word.size()) << 24;
+		return static_cast<std::uint32_t>(key * Lexer::reservedWordMultiplier) >> (32 - Lexer::reservedWordSlotBits);
+	}
+
+	// Slot -> index in reservedWords + 1 (0 is an empty slot).
+	constexpr std::array<std::uint8_t, 1 << Lexer::reservedWordSlotBits> makeReservedWordSlots(void)
+	{
+		std::array<std::uint8_t, 1 << Lexer::reservedWordSlotBits> slots{};
+		for (std::size_t i = 0; i < Lexer::reservedWords.size(); i++)
+		{
+			std::uint8_t& slot = slots[Lexer::reservedWordHash(Lexer::reservedWords[i].text)];
+			if (slot) return {}; // Collision. The static_assert below fails.
+			slot = static_cast<std::uint8_t>(i + 1);
+		}
+		return slots;
+	}
+
+	inline constexpr std::array<std::uint8_t, 1 << Lexer::reservedWordSlotBits> reservedWordSlots = Lexer::makeReservedWordSlots();
+
+	constexpr bool isReservedWordHashPerfect(void)
+	{
+		for (const Lexer::ReservedWord& reservedWord : Lexer::reservedWords)
+		{
+			if (reservedWord.text.size() < 2) return false;
+			std::uint8_t slot = Lexer::reservedWordSlots[Lexer::reservedWordHash(reservedWord.text)];
+			if (not slot or Lexer::reservedWords[slot - 1].text != reservedWord.text) return false;
+		}
+		return true;
+	}
+	static_assert(Lexer::isReservedWordHashPerfect(), "Two reserved words share a slot. Change reservedWordMultiplier");
+
+	// nullptr if word is an identifier.
+	constexpr const Lexer::ReservedWord* findReservedWord(const std::string_view& word)
+	{
+		if (word.size() < 2) return nullptr;
+
+		std::uint8_t slot = Lexer::reservedWordSlots[Lexer::reservedWordHash(word)];
+		if (not slot or Lexer::reservedWords[slot - 1].text != word) return nullptr;
+		return &Lexer::reservedWords[slot - 1];
+	}
+}
@@ -0,0 +1,928 @@
+#include "../Lexer/Scanner.hpp"
+#include "../Lexer/CharClass.hpp"
+#include "../Lexer/ReservedWord.hpp"
+#include "../Lexer/Punctuator.hpp"
+#include "../Helper/Simd.hpp"
+#include "../Helper/Assert.hpp"
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <cctype>
+#include <cmath>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+
+Lexer::Scanner::Scanner(void)
+    : m_droppedSize(0), m_lineEnd(nullptr), m_source(nullptr), m_stop(nullptr), m_isFinished(false), m_isRestartable(true), m_pendingIndex(0),
+    m_depthClosingCount(0), m_shouldCheckIndentFlag(true), m_shouldDecodeLiterals(false), m_linesCount(1), m_currentLineStart(nullptr)
+{
+}
+Lexer::Scanner::Scanner(const std::string_view& source)
+    : m_droppedSize(0), m_view(source), m_lineEnd(nullptr), m_source(source.data()), m_stop(nullptr), m_isFinished(true), m_isRestartable(true), m_pendingIndex(0),
+    m_depthClosingCount(0), m_shouldCheckIndentFlag(true), m_shouldDecodeLiterals(false), m_linesCount(1), m_currentLineStart(source.data())
+{
+}
+Lexer::Scanner::Scanner(const std::string_view& source, const Lexer::Scanner::State& state, std::size_t stopOffset)
+    : m_droppedSize(0), m_view(source.substr(state.offset)), m_lineEnd(nullptr), m_source(source.data()),
+    m_stop(stopOffset < source.size() ? source.data() + stopOffset : nullptr), m_isFinished(true), m_isRestartable(true), m_pendingIndex(0),
+    m_identLevels(state.identLevels), m_depthClosingCount(state.depthClosingCount), m_shouldCheckIndentFlag(state.shouldCheckIndentFlag), m_shouldDecodeLiterals(false),
+    m_linesCount(state.linesCount), m_currentLineStart(source.data() + state.currentLineOffset)
+{
+}
+
+void Lexer::Scanner::feed(const std::string_view& chunk)
+{
+    Assert_Message(not this->m_isFinished, "Can't feed a finished (Or a whole source) Scanner");
+
+    // Scan for weird chars.
+    if (not Lexer::Scanner::isPrintable(chunk))
+    {
+        this->m_errors.emplace_back(0, "Unprintable chars. UTF16 is probably used");
+        this->m_view = std::string_view();
+        this->m_isFinished = true;
+        return;
+    }
+
+    // Drop what was already lexed. Only keep the current line (For errors) and the content of pending tokens.
+    const char* oldBase = this->m_buffer.data();
+    const char* oldEnd = this->m_view.data() + this->m_view.size();
+    const char* keepFrom = this->m_view.data();
+    if (this->m_currentLineStart) keepFrom = std::min(keepFrom, this->m_currentLineStart);
+    for (std::size_t i = this->m_pendingIndex; i < this->m_pending.size(); i++)
+    {
+        if (this->m_pending[i].content.data()) keepFrom = std::min(keepFrom, this->m_pending[i].content.data());
+    }
+    if (this->m_lineEnd and this->m_lineEnd < this->m_view.data()) this->m_lineEnd = nullptr; // Already behind, step() cuts it again anyway.
+    bool wasLineComplete = this->m_lineEnd and this->m_lineEnd != oldEnd;
+
+    std::size_t dropSize = keepFrom - oldBase;
+    this->m_buffer.erase(this->m_buffer.begin(), this->m_buffer.begin() + dropSize);
+    this->m_droppedSize += dropSize;
+    this->m_buffer.insert(this->m_buffer.end(), chunk.begin(), chunk.end());
+
+    // The buffer moved. Move every pointer into it too.
+    const char* newBase = this->m_buffer.data();
+    const char* newEnd = newBase + this->m_buffer.size();
+    auto rebase = [oldBase, newBase, dropSize](const char* pointer) -> const char*
+    {
+        return pointer ? newBase + (pointer - oldBase - dropSize) : nullptr;
+    };
+
+    const char* viewStart = this->m_view.data() ? rebase(this->m_view.data()) : newBase;
+    this->m_view = std::string_view(viewStart, newEnd - viewStart);
+    this->m_currentLineStart = this->m_currentLineStart ? rebase(this->m_currentLineStart) : viewStart;
+    this->m_lineEnd = rebase(this->m_lineEnd);
+    if (this->m_lineEnd and not wasLineComplete) // The '\n' might be in the new chunk.
+    {
+        this->m_lineEnd += Helper::Simd::findNewLine(std::string_view(this->m_lineEnd, newEnd - this->m_lineEnd));
+    }
+
+    this->m_pending.erase(this->m_pending.begin(), this->m_pending.begin() + this->m_pendingIndex);
+    this->m_pendingIndex = 0;
+    for (Lexer::Token& token : this->m_pending)
+    {
+        if (token.content.data()) token.content = std::string_view(rebase(token.content.data()), token.content.size());
+    }
+}
+void Lexer::Scanner::finish(void)
+{
+    this->m_isFinished = true;
+}
+void Lexer::Scanner::decodeLiterals(void)
+{
+    this->m_shouldDecodeLiterals = true;
+}
+
+std::optional<Lexer::Token> Lexer::Scanner::next(void)
+{
+    if (not this->fill(1)) return std::nullopt;
+
+    // Every token points into the source, also the ones without content (See Lexer::Token::offset). So the position is one subtraction.
+    Lexer::Token token = this->m_pending[this->m_pendingIndex++];
+    token.offset = this->offsetOf(token.content.data());
+    return token;
+}
+std::optional<Lexer::Token> Lexer::Scanner::peek(std::size_t k)
+{
+    if (not this->fill(k + 1)) return std::nullopt;
+
+    Lexer::Token token = this->m_pending[this->m_pendingIndex + k];
+    token.offset = this->offsetOf(token.content.data());
+    return token;
+}
+bool Lexer::Scanner::atEnd(void) const
+{
+    return this->m_isFinished and (this->m_view.empty() or this->isStopped()) and this->m_pendingIndex == this->m_pending.size();
+}
+Lexer::Scanner::State Lexer::Scanner::state(void) const
+{
+    Assert_Message(this->m_source, "Chunks mode has no offsets");
+
+    Lexer::Scanner::State state;
+    state.offset = this->m_view.data() - this->m_source;
+    state.linesCount = this->m_linesCount;
+    state.currentLineOffset = this->m_currentLineStart - this->m_source;
+    state.depthClosingCount = this->m_depthClosingCount;
+    state.shouldCheckIndentFlag = this->m_shouldCheckIndentFlag;
+    state.identLevels = this->m_identLevels;
+    return state;
+}
+std::size_t Lexer::Scanner::offset(void) const
+{
+    Assert_Message(this->m_source, "Chunks mode has no offsets");
+    return this->m_view.data() - this->m_source;
+}
+bool Lexer::Scanner::isAtRestartPoint(void) const
+{
+    return this->m_isRestartable and this->m_shouldCheckIndentFlag and not this->m_depthClosingCount and this->m_view.data() == this->m_currentLineStart
+        and this->m_pendingIndex == this->m_pending.size();
+}
+
+const Lexer::Stats& Lexer::Scanner::stats(void) const
+{
+    return this->m_stats;
+}
+
+const std::vector<Lexer::Diagnostic>& Lexer::Scanner::errors(void) const
+{
+    return this->m_errors;
+}
+std::vector<Lexer::Diagnostic> Lexer::Scanner::takeErrors(void)
+{
+    return std::exchange(this->m_errors, {});
+}
+
+bool Lexer::Scanner::isPrintable(const std::string_view& text)
+{
+    for (unsigned char c : text)
+    {
+        if (not std::isprint(c) and not std::iscntrl(c))
+        {
+            // I ain't doing UTF16.
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Lexer::Scanner::fill(std::size_t count)
+{
+    // Forget the tokens that were already returned, so m_pending never grows.
+    if (this->m_pendingIndex == this->m_pending.size())
+    {
+        this->m_pending.clear();
+        this->m_pendingIndex = 0;
+    }
+
+    while (this->m_pending.size() - this->m_pendingIndex < count)
+    {
+        if (not this->step()) return false;
+    }
+    return true;
+}
+bool Lexer::Scanner::isLineComplete(void) const
+{
+    return this->m_isFinished or this->m_lineEnd != this->m_view.data() + this->m_view.size();
+}
+bool Lexer::Scanner::isStopped(void) const
+{
+    return this->m_stop and this->m_view.data() >= this->m_stop;
+}
+std::uint32_t Lexer::Scanner::offsetOf(const char* pointer) const
+{
+    if (this->m_source) return static_cast<std::uint32_t>(pointer - this->m_source);
+    return static_cast<std::uint32_t>(pointer - this->m_buffer.data() + this->m_droppedSize);
+}
+
+// Guidelines: 
+// 1. Every (with exceptions) extract'XTag' gets a view that is already cut at the '\n' (step() cuts it once per line).
+// Still it must start with this code chunk.
+// std::string_view fixedView = view;
+// if (fixedView.empty()) return std::nullopt;
+// And later code only use fixedView and not view. Only after 100% of extracting/scanning everything you are allowed to do view.remove_prefix(x);
+// This is to avoid chars after the \n. (Please even if it seams not unnecessary or slow or unoptimized keep it).
+// 2. If you perform multiple scans in one function keep a variable named std::size_t totalSize = 0; as the first chunk above them.
+// This will make it easier to know at which column to report errors or just calculate sizes. This is not a must but recommended.
+// Also make sure that you do 'totalSize++' next to something like 'i++' eg: for (...; ...; i++, totalSize++).
+// 3. Errors are returned (return std::unexpected(Lexer::Scanner::Error(...));) and never thrown.
+// step() records them (See report()) and skips the rest of the line, so a file full of errors lexes as fast as a clean one.
+
+// How this lexer work?
+// Basic concept: I first skip all the spaces and look at the first char of the current word.
+// The first char tells which tokens are possible (See Lexer::CharClass), so I only try to match those one by one.
+// If it match I append to the tokens. Else I check other tokens.
+// Extra more complex concept: Every '\n' I check for indention level (number of spaces and tabs).
+// If I ecounter a (... or [... I stop this checking until I find an ending ...) or ...].
+// Every step() is one round of this and makes zero or more tokens (Many DEDENTs at once for example).
+
+bool Lexer::Scanner::step(void)
+{
+    std::string_view& view = this->m_view;
+
+    // Early return.
+    if (view.empty() or this->isStopped()) return false;
+
+    // Cut the line once and not in every extractor. Only a new line or a triple string literal can move 'view' past it.
+    if (not this->m_lineEnd or view.data() > this->m_lineEnd)
+    {
+        this->m_lineEnd = view.data() + Helper::Simd::findNewLine(view);
+        this->m_stats.countLineCut(this->m_lineEnd - view.data());
+    }
+    if (not this->isLineComplete()) return false; // Wait for the rest of the line.
+
+    const char* stepStart = view.data();
+
+    // Newline must be first.
+    // This avoids the other extract function getting a string like that "\nx = 1234" and converting it into "".
+    // This could prevent bugs.
+    if (auto opt = this->m_stats.measure(Lexer::Extractor::NEW_LINE, [&] { return Lexer::Scanner::extractNewLine(view); }))
+    {
+        this->m_currentLineStart = view.data();
+        this->m_linesCount++;
+        this->m_shouldCheckIndentFlag = true;
+        this->m_pending.emplace_back(opt.value());
+        this->m_stats.countScanned(view.data() - stepStart);
+        return true;
+    }
+
+    // Sorry for this ugly nesting. It's required and there is no better way to do it.
+    if (this->m_shouldCheckIndentFlag) // If newline and no closing depth.
+    {
+        if (not this->m_depthClosingCount) // This is nested here and not if (shouldCheckIndentFlag and not depthClosingCount) above. To make shouldCheckIndentFlag = false;.
+        {
+            // Straight into the pending tokens, no vector for every dedent.
+            auto result = this->m_stats.measure(Lexer::Extractor::IN_DEDENT, [&] { return Lexer::Scanner::extractInDedent(view, this->m_identLevels, this->m_pending); });
+            if (not result)
+            {
+                this->report(result.error()); // The next line is checked again.
+                this->m_stats.countScanned(view.data() - stepStart);
+                return true;
+            }
+        }
+        this->m_shouldCheckIndentFlag = false;
+        this->m_stats.countScanned(view.data() - stepStart);
+        return true;
+    }
+
+    Lexer::Scanner::skipSpaces(view);
+
+    // A triple string literal can end lines later. In chunks mode wait until it does (Or until there are no more chunks).
+    if (not this->m_isFinished and view.starts_with("\"\"\"") and view.find("\"\"\"", std::strlen("\"\"\"")) == std::string_view::npos)
+    {
+        return false;
+    }
+
+    // Only the extractors that can start with view.front() are tried (See Lexer::CharClass).
+    std::string_view tokenView = view;
+    Lexer::Scanner::Extracted result = Lexer::Scanner::extractToken(view, this->m_lineEnd, this->m_depthClosingCount, this->m_stats);
+    if (not result)
+    {
+        // A triple string literal that does not end looked at the whole rest of the source. Nothing after it is only made of the bytes before it.
+        if (view.starts_with("\"\"\"")) this->m_isRestartable = false;
+
+        this->report(result.error());
+        this->m_stats.countScanned(view.data() - stepStart);
+        return true;
+    }
+    if (result.value())
+    {
+        Lexer::Token& token = this->m_pending.emplace_back(result.value().value());
+        if (this->m_shouldDecodeLiterals and Lexer::Literal::isNumber(token.tag))
+        {
+            // The digits were just checked, so they are still in the cache.
+            auto literal = Lexer::Scanner::decodeLiteral(token);
+            if (not literal)
+            {
+                this->m_pending.pop_back();
+                view = tokenView; // The error is at the start of the number.
+                this->report(literal.error());
+                this->m_stats.countScanned(view.data() - stepStart);
+                return true;
+            }
+            token.literal = literal.value();
+        }
+        this->m_stats.countScanned(view.data() - stepStart);
+        return true;
+    }
+
+    // This section happens if it's a comment. 
+    Lexer::Scanner::incrementToNextLine(view, this->m_lineEnd);
+    this->m_currentLineStart = view.data();
+    this->m_linesCount++;
+    this->m_stats.countScanned(view.data() - stepStart);
+
+    return true;
+}
+
+void Lexer::Scanner::report(const Lexer::Scanner::Error& error)
+{
+    std::string_view& view = this->m_view;
+
+    // The line of the last new line. An error never happens on an empty line, so it's never empty.
+    std::string_view currentLine(this->m_currentLineStart, view.data() + view.size() - this->m_currentLineStart);
+    currentLine = currentLine.substr(0, Helper::Simd::findNewLine(currentLine));
+
+    std::string_view fixedLine = currentLine;
+    Lexer::Scanner::skipSpaces(fixedLine);
+
+    std::size_t distance;
+    if (error.column == std::string_view::npos)
+    {
+        distance = 0;
+    }
+    else
+    {
+        distance = std::abs((view.data() - fixedLine.data())) + error.column;
+    }
+    this->m_errors.emplace_back(this->m_linesCount, error.error, fixedLine, distance);
+    this->m_stats.countError();
+
+    // The rest of the line is skipped.
+    Lexer::Scanner::incrementToNextLine(view, this->m_lineEnd);
+    this->m_currentLineStart = view.data();
+    this->m_linesCount++;
+}
+bool Lexer::Scanner::isDone(const Lexer::Scanner::Extracted& result)
+{
+    return not result or result.value();
+}
+
+void Lexer::Scanner::skipSpaces(std::string_view& view)
+{
+    view.remove_prefix(Helper::Simd::countBlanks(view));
+}
+void Lexer::Scanner::incrementToNextLine(std::string_view& view, const char* lineEnd)
+{
+    // Jump over the rest of the line and its '\n' (If there is one).
+    std::size_t distance = lineEnd - view.data();
+    view.remove_prefix(std::min(view.size(), distance + std::strlen("\n")));
+}
+
+std::optional<std::size_t> Lexer::Scanner::extractSpacesLevel(const std::string_view& view)
+{
+    // Scan.
+    std::string_view temp = view;
+    std::size_t level = 0;
+    while (not temp.empty() and (temp.front() == ' ' or temp.front() == '\t'))
+    {
+        level += temp.front() == ' ';
+        level += (temp.front() == '\t') * 4;
+        temp.remove_prefix(1);
+    }
+    if (not temp.empty() and (temp.front() == '\n' or temp.front() == '#')) return std::nullopt; // If empty string or is a comment.
+
+    // Return.
+    return level;
+}
+std::optional<std::string_view> Lexer::Scanner::extractUntilNotAlnum(const std::string_view& view)
+{
+    // Forced Code.
+    std::string_view fixedView = view;
+    if (fixedView.empty()) return std::nullopt;
+    
+    // Scan.
+    std::size_t i = Helper::Simd::countWordChars(fixedView);
+    if (i == 0) return std::nullopt;
+
+    // Return.
+    return fixedView.substr(0, i);
+}
+
+Lexer::Scanner::Extracted Lexer::Scanner::extractToken(std::string_view& view, const char* lineEnd, std::size_t& depthClosingCount, Lexer::Stats& stats)
+{
+    // Every extractor (but the triple string literal) only gets the current line.
+    std::string_view lineView = view.substr(0, lineEnd - view.data());
+    Lexer::Scanner::Extracted result = Lexer::Scanner::extractLineToken(view, lineView, depthClosingCount, stats);
+
+    // Incrementation.
+    if (lineView.data() > view.data()) view.remove_prefix(lineView.data() - view.data());
+
+    // Return.
+    return result;
+}
+Lexer::Scanner::Extracted Lexer::Scanner::extractLineToken(std::string_view& view, std::string_view& lineView, std::size_t& depthClosingCount, Lexer::Stats& stats)
+{
+    // Early return.
+    if (lineView.empty()) return std::nullopt;
+
+    // Dispatch.
+    // Every case tries the same extractors (and in the same order) that the full chain of extractors would have reached.
+    // So the tokens and the errors stay exactly the same.
+    switch (Lexer::charClasses[static_cast<unsigned char>(lineView.front())])
+    {
+    case Lexer::CharClass::QUOTE:
+        if (auto result = stats.measure(Lexer::Extractor::STRING3_LITERAL, [&] { return Lexer::Scanner::extractString3Literal(view); }); Lexer::Scanner::isDone(result)) return result;
+        return stats.measure(Lexer::Extractor::STRING_LITERAL, [&] { return Lexer::Scanner::extractStringLiteral(lineView); });
+
+    case Lexer::CharClass::APOSTROPHE:
+        return stats.measure(Lexer::Extractor::CHAR_LITERAL, [&] { return Lexer::Scanner::extractCharLiteral(lineView); });
+
+    case Lexer::CharClass::ZERO:
+        if (auto result = stats.measure(Lexer::Extractor::HEX_LITERAL, [&] { return Lexer::Scanner::extractHexLiteral(lineView); }); Lexer::Scanner::isDone(result)) return result;
+        if (auto result = stats.measure(Lexer::Extractor::BIN_LITERAL, [&] { return Lexer::Scanner::extractBinLiteral(lineView); }); Lexer::Scanner::isDone(result)) return result;
+        if (auto result = stats.measure(Lexer::Extractor::OCT_LITERAL, [&] { return Lexer::Scanner::extractOctLiteral(lineView); }); Lexer::Scanner::isDone(result)) return result;
+        [[fallthrough]];
+    case Lexer::CharClass::DIGIT:
+        if (auto result = stats.measure(Lexer::Extractor::SCI_LITERAL, [&] { return Lexer::Scanner::extractSciLiteral(lineView); }); Lexer::Scanner::isDone(result)) return result;
+        // Float before int because a string like this "1234.1234" will become: [INT_LITERAL: '1234'], [SYMBOL: '.'], [INT_LITERAL: '1234']
+        if (auto result = stats.measure(Lexer::Extractor::FLOAT_LITERAL, [&] { return Lexer::Scanner::extractFloatLiteral(lineView); }); Lexer::Scanner::isDone(result)) return result;
+        return stats.measure(Lexer::Extractor::INT_LITERAL, [&] { return Lexer::Scanner::extractIntLiteral(lineView); }); // Always matches a digit.
+
+    case Lexer::CharClass::DOT:
+        if (auto result = stats.measure(Lexer::Extractor::SCI_LITERAL, [&] { return Lexer::Scanner::extractSciLiteral(lineView); }); Lexer::Scanner::isDone(result)) return result;
+        if (auto result = stats.measure(Lexer::Extractor::FLOAT_LITERAL, [&] { return Lexer::Scanner::extractFloatLiteral(lineView); }); Lexer::Scanner::isDone(result)) return result;
+        return stats.measure(Lexer::Extractor::SYMBOL, [&] { return Lexer::Scanner::extractSymbol(lineView, depthClosingCount); });
+
+    case Lexer::CharClass::WORD:
+        return stats.measure(Lexer::Extractor::WORD, [&] { return Lexer::Scanner::extractWord(lineView); }); // Keywords, word symbols, True, False, None and identifiers at once.
+
+    case Lexer::CharClass::PUNCTUATOR:
+        if (auto opt = stats.measure(Lexer::Extractor::SYMBOL, [&] { return Lexer::Scanner::extractSymbol(lineView, depthClosingCount); })) return opt;
+        return stats.measure(Lexer::Extractor::IDENTIFIER, [&] { return Lexer::Scanner::extractIdentifier(lineView); }); // A lonely '!'. An "Invalid character" error.
+
+    case Lexer::CharClass::INVALID:
+        return stats.measure(Lexer::Extractor::IDENTIFIER, [&] { return Lexer::Scanner::extractIdentifier(lineView); }); // An "Invalid character" error.
+
+    case Lexer::CharClass::COMMENT: // Handled by the Generator.
+    case Lexer::CharClass::NEW_LINE:
+    case Lexer::CharClass::SPACE:
+        return std::nullopt;
+    }
+
+    // Return default.
+    return std::nullopt;
+}
+Lexer::Scanner::Extracted Lexer::Scanner::extractString3Literal(std::string_view& view)
+{
+    // Early return.
+    if (not view.starts_with("\"\"\"")) return std::nullopt;
+
+    // Scan.
+    std::size_t endPos = view.find("\"\"\"", std::strlen("\"\"\""));
+    if (endPos == std::string_view::npos)
+    {
+        return std::unexpected(Lexer::Scanner::Error("Triple string literal does not end"));
+    }
+    endPos += std::strlen("\"\"\"");
+    std::string_view string3Literal = view.substr(0, endPos);
+
+    // Incrementation & return.
+    std::string_view content = string3Literal;
+    view.remove_prefix(endPos);
+    return Lexer::Token(Lexer::Tag::STRING3_LITERAL, content);
+}
+Lexer::Scanner::Extracted Lexer::Scanner::extractStringLiteral(std::string_view& view)
+{
+    // Forced Code.
+    std::string_view fixedView = view;
+    if (fixedView.empty()) return std::nullopt;
+
+    // Early return.
+    if (not (fixedView.front() == '\"')) return std::nullopt;
+
+    // Scan.
+    char prev = ' ';
+    auto endPosIt = std::find_if(fixedView.begin() + 1, fixedView.end(), [&prev] (char c) -> bool
+    {
+        if (c == '\"' and prev != '\\')
+        {
+            return true;
+        }
+
+        prev = c;
+        return false;
+    });
+    if (endPosIt == fixedView.end())
+    {
+        return std::unexpected(Lexer::Scanner::Error("String literal does not end at current line"));
+    }
+    std::size_t endPos = std::distance(fixedView.begin(), endPosIt) + std::strlen("\"");
+    std::string_view stringLiteral = fixedView.substr(0, endPos);
+
+    // Incrementation & return.
+    std::string_view content = stringLiteral;
+    view.remove_prefix(endPos);
+    return Lexer::Token(Lexer::Tag::STRING_LITERAL, content);
+}
+Lexer::Scanner::Extracted Lexer::Scanner::extractCharLiteral(std::string_view& view)
+{
+    // Forced Code.
+    std::string_view fixedView = view;
+    if (fixedView.empty()) return std::nullopt;
+
+    // Early return.
+    if (not (fixedView.front() == '\'')) return std::nullopt;
+
+    // Scan.
+    char prev = ' ';
+    auto endPosIt = std::find_if(fixedView.begin() + 1, fixedView.end(), [&prev](char c) -> bool
+    {
+        if (c == '\'' and prev != '\\')
+        {
+            return true;
+        }
+
+        prev = c;
+        return false;
+    });
+    if (endPosIt == fixedView.end())
+    {
+        return std::unexpected(Lexer::Scanner::Error("Character literal does not end at current line"));
+    }
+    std::size_t endPos = std::distance(fixedView.begin(), endPosIt) + std::strlen("\'");
+    std::string_view charLiteral = fixedView.substr(0, endPos);
+    if (charLiteral.size() >= 2 // Bounds checking.
+        and charLiteral.size() > (std::strlen("'a'") + (charLiteral[1] == '\\'))) // Checks if it's bypassing the length of 'a' or the length of '\n' if there was a '\' before.
+        return std::unexpected(Lexer::Scanner::Error("Character literal is more than character", std::strlen("'a") + (charLiteral[1] == '\\'))); // I did not mistake with "'a" it doesn't end with an ' on purpose.
+
+    // Incrementation & return.
+    std::string_view content = charLiteral;
+    view.remove_prefix(endPos);
+    return Lexer::Token(Lexer::Tag::CHAR_LITERAL, content);
+}
+Lexer::Scanner::Extracted Lexer::Scanner::extractHexLiteral(std::string_view& view)
+{
+    // Forced Code.
+    std::size_t totalSize = 0;
+    std::string_view fixedView = view;
+    if (fixedView.empty()) return std::nullopt;
+
+    // Early errors/return.
+    if ((not fixedView.starts_with("0x") and not fixedView.starts_with("0X"))) return std::nullopt;
+    if (fixedView.size() <= 2) return std::unexpected(Lexer::Scanner::Error("Invalid hexadecimal literal"));
+    totalSize += std::strlen("0x");
+
+    // Scan.
+    std::string_view afterSignature = fixedView.substr(totalSize);
+    for (afterSignature; not afterSignature.empty(); afterSignature.remove_prefix(1), totalSize++)
+    {
+        unsigned char c = static_cast<unsigned char>(afterSignature.front());
+
+        if (not std::isalnum(c)) break;
+        if (std::string_view("0123456789ABCDEFabcdef").find(c) == std::string_view::npos) return std::unexpected(Lexer::Scanner::Error("Invalid hexadecimal literal", totalSize));
+    }
+
+    // Incrementation & return.
+    std::string_view content = fixedView.substr(0, totalSize);
+    view.remove_prefix(content.size());
+    return Lexer::Token(Lexer::Tag::HEX_LITERAL, content);
+}
+
+Lexer::Scanner::Extracted Lexer::Scanner::extractBinLiteral(std::string_view& view)
+{
+    std::size_t totalSize = 0;
+    std::string_view fixedView = view;
+    if (fixedView.empty()) return std::nullopt;
+
+    // Early return.
+    if ((not fixedView.starts_with("0b") and not fixedView.starts_with("0B"))) return std::nullopt;
+    if (fixedView.size() <= 2) return std::unexpected(Lexer::Scanner::Error("Invalid binary literal"));
+    totalSize += std::strlen("0b");
+
+    // Scan.
+    std::string_view afterSignature = fixedView.substr(totalSize);
+    for (afterSignature; not afterSignature.empty(); afterSignature.remove_prefix(1), totalSize++)
+    {
+        unsigned char c = static_cast<unsigned char>(afterSignature.front());
+
+        if (not std::isalnum(c)) break;
+        if (std::string_view("01").find(c) == std::string_view::npos) return std::unexpected(Lexer::Scanner::Error("Invalid binary literal", totalSize));
+    }
+
+    // Incrementation & return.
+    std::string_view content = fixedView.substr(0, totalSize);
+    view.remove_prefix(content.size());
+    return Lexer::Token(Lexer::Tag::BIN_LITERAL, content);
+}
+Lexer::Scanner::Extracted Lexer::Scanner::extractOctLiteral(std::string_view& view)
+{
+    // Forced Code.
+    std::size_t totalSize = 0;
+    std::string_view fixedView = view;
+    if (fixedView.empty()) return std::nullopt;
+
+    // Early return.
+    if ((not fixedView.starts_with("0o") and not fixedView.starts_with("0O"))) return std::nullopt;
+    if (fixedView.size() <= 2) return std::unexpected(Lexer::Scanner::Error("Invalid octal literal"));
+    totalSize += std::strlen("0o");
+
+    // Scan.
+    std::string_view afterSignature = fixedView.substr(totalSize);
+    for (afterSignature; not afterSignature.empty(); afterSignature.remove_prefix(1), totalSize++)
+    {
+        unsigned char c = static_cast<unsigned char>(afterSignature.front());
+
+        if (not std::isalnum(c)) break;
+        if (std::string_view("01234567").find(c) == std::string_view::npos) return std::unexpected(Lexer::Scanner::Error("Invalid octal literal", totalSize));
+    }
+
+    // Incrementation & return.
+    std::string_view content = fixedView.substr(0, totalSize);
+    view.remove_prefix(content.size());
+    return Lexer::Token(Lexer::Tag::OCT_LITERAL, content);
+}
+Lexer::Scanner::Extracted Lexer::Scanner::extractSciLiteral(std::string_view& view)
+{
+    // Forced Code.
+    std::size_t totalSize = 0;
+    std::string_view fixedView = view;
+    if (fixedView.empty()) return std::nullopt;
+
+    // Early return.
+    if (fixedView.size() <= 2) return std::nullopt;
+    if (fixedView.front() == '.' and not std::isdigit(static_cast<unsigned char>(fixedView[1]))) return std::nullopt; // '.a'
+    if (fixedView[1] == '.' and not std::isdigit(static_cast<unsigned char>(fixedView.front()))) return std::nullopt; // 'a.'
+    if (fixedView.front() != '.' and not std::isdigit(static_cast<unsigned char>(fixedView.front()))) return std::nullopt; // 'a'
+
+    // Scan 1.
+    bool seenE = false;
+    bool seenDot = false;
+    for (std::size_t i = 0; i < fixedView.size(); i++, totalSize++)
+    {
+        std::size_t digits = Helper::Simd::countDigits(fixedView.substr(i)); // Digits never stop the scan so jump over all of them.
+        i += digits;
+        totalSize += digits;
+        if (i == fixedView.size()) break;
+        unsigned char c = std::tolower(static_cast<unsigned char>(fixedView[i]));
+
+        if (c == 'e')
+        {
+            seenE = true;
+            break;
+        }
+
+        if (c == '.')
+        {
+            if (seenDot)
+            {
+                return std::unexpected(Lexer::Scanner::Error("Invalid float literal", totalSize));
+            }
+            seenDot = true;
+            continue;
+        }
+
+        if (std::isalpha(c))
+        {
+            if (seenDot)
+            {
+                return std::unexpected(Lexer::Scanner::Error("Invalid float literal", totalSize));
+            }
+            return std::unexpected(Lexer::Scanner::Error("Invalid integer literal", totalSize)); // If there was no dot it means it's an int literal.
+        }
+        if (not std::isalnum(c)) break;
+    }
+    if (not seenE) return std::nullopt;
+    totalSize += std::strlen("e");
+
+    std::string_view afterE = fixedView.substr(totalSize);
+    if (afterE.empty()) return std::unexpected(Lexer::Scanner::Error("Invalid scientific notation literal", totalSize));
+
+    // Scan 2.
+    if (afterE.front() == '+' or afterE.front() == '-')
+    {
+        afterE.remove_prefix(1);
+        totalSize++;
+    }
+    bool seen = false;
+    for (afterE; not afterE.empty(); afterE.remove_prefix(1), totalSize++)
+    {
+        unsigned char c = std::tolower(static_cast<unsigned char>(afterE.front()));
+
+        if (std::isalpha(c)) return std::unexpected(Lexer::Scanner::Error("Invalid scientific notation literal", totalSize));
+        if (not std::isalnum(c)) break;
+
+        seen = true;
+    }
+    if (not seen) return std::unexpected(Lexer::Scanner::Error("Invalid scientific notation literal", totalSize));
+
+    // Incrementation & return.
+    std::string_view content = fixedView.substr(0, totalSize);
+    view.remove_prefix(content.size());
+    return Lexer::Token(Lexer::Tag::SCI_LITERAL, content);
+}
+Lexer::Scanner::Extracted Lexer::Scanner::extractFloatLiteral(std::string_view& view)
+{
+    // Forced Code.
+    std::string_view fixedView = view;
+    if (fixedView.empty()) return std::nullopt;
+
+    // Early return.
+    if (fixedView.size() <= 1) return std::nullopt;
+    if (fixedView.front() == '.' and not std::isdigit(static_cast<unsigned char>(fixedView[1]))) return std::nullopt; // '.a'
+    if (fixedView[1] == '.' and not std::isdigit(static_cast<unsigned char>(fixedView.front()))) return std::nullopt; // 'a.'
+    if (fixedView.front() != '.' and not std::isdigit(static_cast<unsigned char>(fixedView.front()))) return std::nullopt; // 'a'
+
+    // Scan.
+    bool seenDot = false;
+    std::size_t i = 0;
+    for (i = 0; i < fixedView.size(); i++)
+    {
+        i += Helper::Simd::countDigits(fixedView.substr(i)); // Digits never stop the scan so jump over all of them.
+        if (i == fixedView.size()) break;
+        unsigned char c = static_cast<unsigned char>(fixedView[i]);
+
+        if (c == '.')
+        {
+            if (seenDot)
+            {
+                return std::unexpected(Lexer::Scanner::Error("Invalid float literal", i));
+            }
+            seenDot = true;
+            continue;
+        }
+
+        if (std::isalpha(c))
+        {
+            if (seenDot)
+            {
+                return std::unexpected(Lexer::Scanner::Error("Invalid float literal", i));
+            }
+            return std::unexpected(Lexer::Scanner::Error("Invalid integer literal", i)); // If there was no dot it means it's an int literal.
+        }
+        if (not std::isalnum(c)) break;
+    }
+    if (not seenDot) return std::nullopt;
+
+    // Incrementation & return.
+    std::string_view content = fixedView.substr(0, i);
+    view.remove_prefix(content.size());
+    return Lexer::Token(Lexer::Tag::FLOAT_LITERAL, content);
+}
+Lexer::Scanner::Extracted Lexer::Scanner::extractIntLiteral(std::string_view& view)
+{
+    // Forced Code.
+    std::string_view fixedView = view;
+    if (fixedView.empty()) return std::nullopt;
+
+    // Early return.
+    if (not std::isdigit(static_cast<unsigned char>(fixedView.front()))) return std::nullopt;
+
+    // Scan.
+    // The first char after the digits is either a letter (Error) or the end of the literal.
+    std::size_t i = Helper::Simd::countDigits(fixedView);
+    if (i < fixedView.size() and std::isalpha(static_cast<unsigned char>(fixedView[i]))) return std::unexpected(Lexer::Scanner::Error("Invalid integer literal", i));
+
+    // Incrementation & return.
+    std::string_view content = fixedView.substr(0, i);
+    view.remove_prefix(content.size());
+    return Lexer::Token(Lexer::Tag::INT_LITERAL, content);
+}
+
+std::expected<Lexer::Literal, Lexer::Scanner::Error> Lexer::Scanner::decodeLiteral(const Lexer::Token& token)
+{
+    // The extractor already checked every char, so std::from_chars should only fail if the value doesn't fit.
+    // Any other failure is still an error of the source and not an assert (It must never kill the process).
+    const char* first = token.content.data();
+    const char* last = first + token.content.size();
+    Lexer::Literal literal;
+    if (Lexer::Literal::isReal(token.tag))
+    {
+        literal.real = 0.0;
+        auto [end, ec] = std::from_chars(first, last, literal.real);
+        if (ec == std::errc::result_out_of_range)
+        {
+            // Too small for a double is just 0 (Or a denormal), like in strtod. Only too big is an error. Rare, so the copy is fine.
+            literal.real = std::strtod(std::string(token.content).c_str(), nullptr);
+            if (std::isinf(literal.real)) return std::unexpected(Lexer::Scanner::Error("Float literal is too big"));
+            return literal;
+        }
+        if (ec != std::errc() or end != last) return std::unexpected(Lexer::Scanner::Error("Invalid float literal"));
+        return literal;
+    }
+
+    int base = 10;
+    const char* invalid = "Invalid integer literal";
+    switch (token.tag)
+    {
+    case Lexer::Tag::HEX_LITERAL: base = 16; invalid = "Invalid hexadecimal literal"; break;
+    case Lexer::Tag::BIN_LITERAL: base = 2; invalid = "Invalid binary literal"; break;
+    case Lexer::Tag::OCT_LITERAL: base = 8; invalid = "Invalid octal literal"; break;
+    default: break;
+    }
+    if (base != 10) first += std::strlen("0x");
+
+    // The lexer takes a prefix with no digits (Like '0x + 1') as a literal, but it has no value.
+    if (first == last) return std::unexpected(Lexer::Scanner::Error(invalid, std::strlen("0x")));
+
+    literal.integer = 0;
+    auto [end, ec] = std::from_chars(first, last, literal.integer, base);
+    if (ec == std::errc::result_out_of_range) return std::unexpected(Lexer::Scanner::Error("Integer literal is too big"));
+    if (ec != std::errc() or end != last) return std::unexpected(Lexer::Scanner::Error(invalid));
+    return literal;
+}
+std::optional<Lexer::Token> Lexer::Scanner::extractSymbol(std::string_view& view, std::size_t& depthClosingCount)
+{
+    // Forced Code.
+    std::string_view fixedView = view;
+    if (fixedView.empty()) return std::nullopt;
+
+    // Scan. The longest punctuator is found in one walk of a trie (See Lexer::findPunctuator).
+    // The word symbols (and, or...) are reserved words (See Lexer::ReservedWord).
+    const Lexer::Punctuator* punctuator = Lexer::findPunctuator(fixedView);
+    if (not punctuator) return std::nullopt;
+
+    if (punctuator->depth > 0) depthClosingCount++;
+    else if (punctuator->depth < 0 and depthClosingCount > 0) depthClosingCount--;
+
+    // Incrementation & return.
+    std::string_view content = fixedView.substr(0, punctuator->text.size());
+    view.remove_prefix(content.size());
+    return Token(Lexer::Tag::SYMBOL, content, punctuator->kind);
+}
+std::optional<Lexer::Token> Lexer::Scanner::extractWord(std::string_view& view)
+{
+    // Forced code.
+    std::string_view fixedView = view;
+    if (fixedView.empty()) return std::nullopt;
+
+    // Extraction. The run is cut once, and then looked up once (See Lexer::ReservedWord).
+    std::string_view content;
+    if (auto opt = Lexer::Scanner::extractUntilNotAlnum(fixedView)) content = opt.value();
+    else return std::nullopt;
+
+    // Incrementation & return.
+    view.remove_prefix(content.size());
+    if (const Lexer::ReservedWord* reservedWord = Lexer::findReservedWord(content)) return Lexer::Token(reservedWord->tag, content, reservedWord->kind);
+    return Lexer::Token(Lexer::Tag::IDENTIFIER, content);
+}
+std::optional<Lexer::Token> Lexer::Scanner::extractNewLine(std::string_view& view)
+{
+    // Scan.
+    if (view.front() == '\n')
+    {
+        // Incrementation & return. No content, but it still points at its '\n' (For its position).
+        std::string_view content = view.substr(0, 0);
+        view.remove_prefix(std::strlen("\n"));
+        return Lexer::Token(Lexer::Tag::NEW_LINE, content);
+    }
+
+    return std::nullopt;
+}
+std::expected<std::size_t, Lexer::Scanner::Error> Lexer::Scanner::extractInDedent(std::string_view& view, Lexer::Scanner::IndentLevels& identLevels, std::vector<Lexer::Token>& tokens)
+{
+    // Early return.
+    std::size_t newLevel;
+    if (auto opt = Lexer::Scanner::extractSpacesLevel(view)) newLevel = opt.value();
+    else return 0;
+    if (identLevels.empty() and newLevel == 0)
+    {
+        return 0;
+    }
+
+    // INDENT and DEDENT point at the first char after the indention (For their position).
+    std::string_view position = view.substr(Helper::Simd::countBlanks(view), 0);
+
+    // Scan 1.
+    if (identLevels.empty() or newLevel > identLevels.top()) 
+    {
+        identLevels.push(newLevel);
+        tokens.emplace_back(Lexer::Tag::INDENT, position);
+        return 1;
+    }
+    else if (identLevels.top() == newLevel)
+    {
+        return 0;
+    }
+
+    // Scan 2.
+    std::size_t size = tokens.size();
+    while (not identLevels.empty() and identLevels.top() > newLevel) 
+    {
+        identLevels.pop();
+        tokens.emplace_back(Lexer::Tag::DEDENT, position);
+    }
+    if ((identLevels.empty() or identLevels.top() != newLevel) and newLevel != 0)
+    {
+        tokens.erase(tokens.begin() + size, tokens.end()); // No dedents on an error (The levels stay popped).
+        return std::unexpected(Lexer::Scanner::Error("Indent (spacing) doesn't match previous indents", std::string_view::npos));
+    }
+
+    // Return.
+    return tokens.size() - size;
+}
+Lexer::Scanner::Extracted Lexer::Scanner::extractIdentifier(std::string_view& view)
+{
+    // Forced code.
+    std::string_view fixedView = view;
+    if (fixedView.empty()) return std::nullopt;
+
+    // Early return/errors.
+    if (fixedView.front() == '#') return std::nullopt;
+    if (not std::isalnum(static_cast<unsigned char>(fixedView.front())) and fixedView.front() != '_') return std::unexpected(Lexer::Scanner::Error("Invalid character"));
+
+    // Extraction.
+    std::string_view content;
+    if (auto opt = Lexer::Scanner::extractUntilNotAlnum(fixedView)) content = opt.value();
+    else return std::nullopt;
+
+    // Incrementation & return.
+    view.remove_prefix(content.size());
+    return Lexer::Token(Lexer::Tag::IDENTIFIER, content);
+}
+
+Lexer::Scanner::Error::Error(const char* new_error, std::size_t new_column)
+    : error(new_error), column(new_column)
+{
+}
@@ -0,0 +1,141 @@
+#pragma once
+#include "../Lexer/Token.hpp"
+#include "../Lexer/Diagnostic.hpp"
+#include "../Lexer/Stats.hpp"
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <stack>
+#include <optional>
+#include <expected>
+
+namespace Lexer
+{
+	// The lexer itself. It makes tokens on demand (next/peek) instead of lexing everything up front.
+	// The only state it keeps is the indent stack, the bracket depth and the line tracking.
+	// It can lex a whole source in place, or chunks that are fed one by one (So a file never has to be fully in memory).
+	// In chunks mode a line is only lexed after its '\n' arrived, and tokens (and their content) stay valid until the next feed().
+	class Scanner
+	{
+	public:
+		using IndentLevels = std::stack<std::size_t, std::vector<std::size_t>>; // A vector and not a deque, so copying a State is cheap.
+
+		// Everything the Scanner knows between two steps. Offsets are from the start of the source.
+		struct State
+		{
+			std::size_t offset = 0; // What is left to lex starts here.
+			std::size_t linesCount = 1;
+			std::size_t currentLineOffset = 0;
+			std::size_t depthClosingCount = 0;
+			bool shouldCheckIndentFlag = true;
+			Lexer::Scanner::IndentLevels identLevels;
+		};
+
+		Scanner(void); // Chunks mode. Use feed() and finish().
+		Scanner(const std::string_view& source); // The whole source. Tokens point into it, so it must outlive them.
+		// Only a part of the whole source. Starts from state and stops at the first step that starts at (Or after) stopOffset.
+		Scanner(const std::string_view& source, const Lexer::Scanner::State& state, std::size_t stopOffset = std::string_view::npos);
+		Scanner(const Lexer::Scanner&) = delete;
+		Lexer::Scanner& operator = (const Lexer::Scanner&) = delete;
+
+		void feed(const std::string_view& chunk);
+		void finish(void); // No more chunks.
+
+		// From now on numbers also get their value (See Lexer::Token::literal), decoded right after they are checked (No second pass).
+		// A number that doesn't fit (Into 64 bits, or a double) is an error. A float that is too small becomes 0.
+		void decodeLiterals(void);
+
+		std::optional<Lexer::Token> next(void); // std::nullopt at the end, or if more chunks are needed.
+		std::optional<Lexer::Token> peek(std::size_t k = 0); // The token that is k tokens after the next one.
+		bool atEnd(void) const;
+		Lexer::Scanner::State state(void) const; // Only for a whole source. Tokens that were not returned yet are not part of it.
+		std::size_t offset(void) const; // Only for a whole source. Where state() would start (Without copying it).
+		// At the start of a line, outside of ( and [, before its indent check, and every token was returned.
+		// Nothing after this point changes state(), so lexing can restart here (See Lexer::Document).
+		bool isAtRestartPoint(void) const;
+
+		const Lexer::Stats& stats(void) const; // All 0 without MONOLITH_STATS (See Lexer::Stats).
+
+		// In chunks mode the code of an error is only valid until the next feed(), like tokens.
+		const std::vector<Lexer::Diagnostic>& errors(void) const;
+		std::vector<Lexer::Diagnostic> takeErrors(void); // Moves the errors out (To keep memory flat while streaming).
+
+		static bool isPrintable(const std::string_view& text);
+
+	private:
+		// An error is returned by the extractor (Never thrown) with where it happened in its view.
+		struct Error
+		{
+			Error(const char* new_error, std::size_t new_column = 0);
+
+			const char* error;
+			std::size_t column;
+		};
+
+		// A token, std::nullopt if the extractor doesn't match, or an error.
+		using Extracted = std::expected<std::optional<Lexer::Token>, Lexer::Scanner::Error>;
+
+		bool fill(std::size_t count);
+		bool step(void);
+		bool isLineComplete(void) const;
+		bool isStopped(void) const;
+		std::uint32_t offsetOf(const char* pointer) const; // From the start of the whole source (Also in chunks mode).
+		void report(const Lexer::Scanner::Error& error); // Records the error and skips the rest of the line.
+
+		static bool isDone(const Lexer::Scanner::Extracted& result); // A token or an error. Both stop the dispatch.
+
+		static void skipSpaces(std::string_view& view);
+		static void incrementToNextLine(std::string_view& view, const char* lineEnd);
+
+		static std::optional<std::size_t> extractSpacesLevel(const std::string_view& view);
+		static std::optional<std::string_view> extractUntilNotAlnum(const std::string_view& view);
+
+		static Lexer::Scanner::Extracted extractToken(std::string_view& view, const char* lineEnd, std::size_t& depthClosingCount, Lexer::Stats& stats);
+		static Lexer::Scanner::Extracted extractLineToken(std::string_view& view, std::string_view& lineView, std::size_t& depthClosingCount, Lexer::Stats& stats);
+		static Lexer::Scanner::Extracted extractString3Literal(std::string_view& view);
+		static Lexer::Scanner::Extracted extractStringLiteral(std::string_view& view);
+		static Lexer::Scanner::Extracted extractCharLiteral(std::string_view& view);
+		static Lexer::Scanner::Extracted extractHexLiteral(std::string_view& view);
+		static Lexer::Scanner::Extracted extractBinLiteral(std::string_view& view);
+		static Lexer::Scanner::Extracted extractOctLiteral(std::string_view& view);
+		static Lexer::Scanner::Extracted extractSciLiteral(std::string_view& view);
+		static Lexer::Scanner::Extracted extractFloatLiteral(std::string_view& view);
+		static Lexer::Scanner::Extracted extractIntLiteral(std::string_view& view);
+		static std::optional<Lexer::Token> extractSymbol(std::string_view& view, std::size_t& skipIndentFlag);
+		static std::optional<Lexer::Token> extractWord(std::string_view& view);
+		static std::optional<Lexer::Token> extractNewLine(std::string_view& view);
+		// Appends to tokens, and returns how many (So Lexer::Stats counts a hit only when there were).
+		static std::expected<std::size_t, Lexer::Scanner::Error> extractInDedent(std::string_view& view, Lexer::Scanner::IndentLevels& identLevels, std::vector<Lexer::Token>& tokens);
+		static Lexer::Scanner::Extracted extractIdentifier(std::string_view& view);
+
+		static std::expected<Lexer::Literal, Lexer::Scanner::Error> decodeLiteral(const Lexer::Token& token); // token is a checked number.
+
+		// Input.
+		std::vector<char> m_buffer; // Only used in chunks mode. Not std::string, small strings would live inside the object.
+		std::size_t m_droppedSize; // Only used in chunks mode. Bytes dropped from the front of m_buffer so far.
+		std::string_view m_view; // What is left to lex.
+		const char* m_lineEnd; // Where the line of m_view ends ('\n' or end of input). nullptr if not cut yet.
+		const char* m_source; // Start of the whole source. nullptr in chunks mode.
+		const char* m_stop; // Lexing stops here. nullptr to lex until the end.
+		bool m_isFinished;
+		bool m_isRestartable; // See isAtRestartPoint.
+
+		// Tokens made by step() but not returned yet.
+		std::vector<Lexer::Token> m_pending;
+		std::size_t m_pendingIndex;
+
+		// For lexering.
+		Lexer::Scanner::IndentLevels m_identLevels;
+		std::size_t m_depthClosingCount; // Checks the depth of ( and [ . Useful for stuff like if ((x < 7) and (1 == 3)):
+		bool m_shouldCheckIndentFlag;
+		bool m_shouldDecodeLiterals;
+
+		// For errors.
+		std::size_t m_linesCount;
+		const char* m_currentLineStart;
+		std::vector<Lexer::Diagnostic> m_errors;
+
+		Lexer::Stats m_stats;
+	};
+}
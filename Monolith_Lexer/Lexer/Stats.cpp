@@ -0,0 +1,75 @@
+#include "../Lexer/Stats.hpp"
+#include "../Helper/Assert.hpp"
+#include <format>
+
+void Lexer::Stats::merge(const Lexer::Stats& other)
+{
+    for (std::size_t i = 0; i < this->extractors.size(); i++)
+    {
+        this->extractors[i].calls += other.extractors[i].calls;
+        this->extractors[i].hits += other.extractors[i].hits;
+        this->extractors[i].errors += other.extractors[i].errors;
+        this->extractors[i].nanoseconds += other.extractors[i].nanoseconds;
+    }
+    this->lineCuts += other.lineCuts;
+    this->lineCutBytes += other.lineCutBytes;
+    this->bytesScanned += other.bytesScanned;
+    this->errors += other.errors;
+}
+std::uint64_t Lexer::Stats::tokensCount(void) const
+{
+    std::uint64_t count = 0;
+    for (const Counter& counter : this->extractors) count += counter.hits;
+    return count;
+}
+
+const char* Lexer::Stats::name(Lexer::Extractor extractor)
+{
+    switch (extractor)
+    {
+    case Lexer::Extractor::STRING3_LITERAL: return "STRING3_LITERAL";
+    case Lexer::Extractor::STRING_LITERAL: return "STRING_LITERAL";
+    case Lexer::Extractor::CHAR_LITERAL: return "CHAR_LITERAL";
+    case Lexer::Extractor::HEX_LITERAL: return "HEX_LITERAL";
+    case Lexer::Extractor::BIN_LITERAL: return "BIN_LITERAL";
+    case Lexer::Extractor::OCT_LITERAL: return "OCT_LITERAL";
+    case Lexer::Extractor::SCI_LITERAL: return "SCI_LITERAL";
+    case Lexer::Extractor::FLOAT_LITERAL: return "FLOAT_LITERAL";
+    case Lexer::Extractor::INT_LITERAL: return "INT_LITERAL";
+    case Lexer::Extractor::SYMBOL: return "SYMBOL";
+    case Lexer::Extractor::WORD: return "WORD";
+    case Lexer::Extractor::NEW_LINE: return "NEW_LINE";
+    case Lexer::Extractor::IN_DEDENT: return "IN_DEDENT";
+    case Lexer::Extractor::IDENTIFIER: return "IDENTIFIER";
+
+    default:
+        Assert_Message(ASSERT_ALWAYS, std::format("Unknown Extractor: {}", static_cast<int>(extractor)));
+    }
+    return "";
+}
+
+std::ostream& Lexer::operator << (std::ostream& stream, const Lexer::Stats& stats)
+{
+    if (not Lexer::Stats::enabled)
+    {
+        stream << "Stats are compiled out. Build with MONOLITH_STATS to count them.\n";
+        return stream;
+    }
+
+    stream << std::format("{:<16}{:>12}{:>12}{:>12}{:>10}{:>9}{:>12}\n", "Extractor", "Calls", "Hits", "Misses", "Errors", "Hit %", "ms");
+    for (std::size_t i = 0; i < stats.extractors.size(); i++)
+    {
+        const Lexer::Stats::Counter& counter = stats.extractors[i];
+        if (not counter.calls) continue;
+
+        std::uint64_t misses = counter.calls - counter.hits - counter.errors;
+        double hitRate = 100.0 * static_cast<double>(counter.hits) / static_cast<double>(counter.calls);
+        stream << std::format("{:<16}{:>12}{:>12}{:>12}{:>10}{:>9.1f}{:>12.3f}\n", Lexer::Stats::name(static_cast<Lexer::Extractor>(i)),
+            counter.calls, counter.hits, misses, counter.errors, hitRate, static_cast<double>(counter.nanoseconds) / 1e6);
+    }
+    stream << std::format("Line cuts: {} ({} bytes)\n", stats.lineCuts, stats.lineCutBytes);
+    stream << std::format("Bytes scanned: {}\n", stats.bytesScanned);
+    stream << std::format("Errors: {}\n", stats.errors);
+
+    return stream;
+}
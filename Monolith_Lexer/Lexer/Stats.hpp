@@ -0,0 +1,118 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <type_traits>
+#include <ostream>
+#include <cstdint>
+#include <cstddef>
+
+namespace Lexer
+{
+	// Every extractor the Scanner can try.
+	enum class Extractor : std::uint8_t
+	{
+		STRING3_LITERAL,
+		STRING_LITERAL,
+		CHAR_LITERAL,
+		HEX_LITERAL,
+		BIN_LITERAL,
+		OCT_LITERAL,
+		SCI_LITERAL,
+		FLOAT_LITERAL,
+		INT_LITERAL,
+		SYMBOL,
+		WORD,
+		NEW_LINE,
+		IN_DEDENT,
+		IDENTIFIER,
+
+		COUNT,
+	};
+
+	// Counters of the Scanner hot path: how often every extractor is tried, how often it matched, and how long it took.
+	// Only counted when built with MONOLITH_STATS (CMake option). Without it every counting call is empty and compiles to nothing,
+	// and all the counters stay 0 (See enabled).
+	struct Stats
+	{
+#if defined(MONOLITH_STATS)
+		static constexpr bool enabled = true;
+#else
+		static constexpr bool enabled = false;
+#endif
+
+		struct Counter
+		{
+			std::uint64_t calls = 0;
+			std::uint64_t hits = 0; // Made a token.
+			std::uint64_t errors = 0; // Returned an error. Calls that are not hits nor errors are misses.
+			std::uint64_t nanoseconds = 0;
+		};
+
+		std::array<Counter, static_cast<std::size_t>(Lexer::Extractor::COUNT)> extractors;
+		std::uint64_t lineCuts = 0; // Searches for the '\n' of a line (Every line is cut once).
+		std::uint64_t lineCutBytes = 0; // Bytes those searches went over.
+		std::uint64_t bytesScanned = 0; // Bytes the Scanner moved over (Tokens, spaces, comments and skipped lines).
+		std::uint64_t errors = 0; // Errors recorded. Only the first error of a line is, the rest of it is skipped.
+
+		// Calls function (An extractor call) and counts it for extractor.
+		template <typename Function>
+		auto measure(Lexer::Extractor extractor, Function&& function) -> decltype(function());
+
+		void countLineCut(std::size_t bytes);
+		void countScanned(std::size_t bytes);
+		void countError(void);
+
+		void merge(const Lexer::Stats& other);
+		std::uint64_t tokensCount(void) const; // Tokens the extractors made (A batch of DEDENTs is one).
+
+		static const char* name(Lexer::Extractor extractor);
+
+		friend std::ostream& operator << (std::ostream& stream, const Lexer::Stats& stats);
+	};
+
+	template <typename Function>
+	auto Lexer::Stats::measure(Lexer::Extractor extractor, Function&& function) -> decltype(function())
+	{
+		if constexpr (not Lexer::Stats::enabled)
+		{
+			return function();
+		}
+		else
+		{
+			auto start = std::chrono::steady_clock::now();
+			auto result = function();
+			auto elapsed = std::chrono::steady_clock::now() - start;
+
+			Counter& counter = this->extractors[static_cast<std::size_t>(extractor)];
+			counter.calls++;
+			counter.nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+			if constexpr (requires { result.error(); }) // Extracted.
+			{
+				if (not result) counter.errors++;
+				else if constexpr (std::is_void_v<typename decltype(result)::value_type>) counter.hits++; // Nothing to tell a miss by.
+				else if (result.value()) counter.hits++;
+			}
+			else if (result)
+			{
+				counter.hits++;
+			}
+			return result;
+		}
+	}
+	inline void Lexer::Stats::countLineCut(std::size_t bytes)
+	{
+		if constexpr (Lexer::Stats::enabled)
+		{
+			this->lineCuts++;
+			this->lineCutBytes += bytes;
+		}
+	}
+	inline void Lexer::Stats::countScanned(std::size_t bytes)
+	{
+		if constexpr (Lexer::Stats::enabled) this->bytesScanned += bytes;
+	}
+	inline void Lexer::Stats::countError(void)
+	{
+		if constexpr (Lexer::Stats::enabled) this->errors++;
+	}
+}
@@ -1,8 +1,9 @@
 #pragma once
+#include <cstdint>
 
 namespace Lexer
 {
-	enum class Tag
+	enum class Tag : std::uint8_t // 1 byte, so it packs tightly (See Lexer::TokenList).
 	{
 		// Literals
 		STRING3_LITERAL,// """Hello, World"""
@@ -1,6 +1,9 @@
 #include "../Lexer/Token.hpp"
 #include "../Helper/Assert.hpp"
 
+const int Lexer::Token::indentCountIndex = std::ios_base::xalloc();
+const int Lexer::Token::shouldPrintIndentsIndex = std::ios_base::xalloc();
+
 Lexer::Token::Token(Lexer::Tag new_tag)
     : tag(new_tag)
 {
@@ -13,20 +16,26 @@ Lexer::Token::Token(Lexer::Tag new_tag, const std::string_view& new_content)
     Assert_Message(this->tag >= Tag::STRING3_LITERAL and this->tag <= Tag::IDENTIFIER, std::format("Unknown Tag: {}", static_cast<int>(this->tag)));
 }
 
+Lexer::Token::Token(Lexer::Tag new_tag, const std::string_view& new_content, Lexer::Kind new_kind)
+    : tag(new_tag), kind(new_kind), content(new_content)
+{
+    Assert_Message(this->tag >= Tag::STRING3_LITERAL and this->tag <= Tag::IDENTIFIER, std::format("Unknown Tag: {}", static_cast<int>(this->tag)));
+}
+
 std::ostream& Lexer::operator << (std::ostream& stream, const Lexer::Token& token)
 {
     // Format: [Tag: 'Content']
     
-    // Not multi-thread safe but it's not a big deal now.
-    static std::size_t indentCount = 0;
-    static bool shouldPrintIndents = false;
+    // The state lives inside the stream itself (And not in a static), so every stream (And thread) has its own.
+    long& indentCount = stream.iword(Lexer::Token::indentCountIndex);
+    long& shouldPrintIndents = stream.iword(Lexer::Token::shouldPrintIndentsIndex);
 
     if (shouldPrintIndents)
     {
         if (token.tag == Lexer::Tag::INDENT) indentCount++;
         else if (token.tag == Lexer::Tag::DEDENT) indentCount--;
 
-        for (std::size_t i = 0; i < indentCount; i++)
+        for (long i = 0; i < indentCount; i++)
         {
             stream << '\t';
         }
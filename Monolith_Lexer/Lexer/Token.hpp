@@ -1,20 +1,40 @@
 #pragma once
 #include "../Lexer/Tag.hpp"
+#include "../Lexer/Kind.hpp"
+#include "../Lexer/Literal.hpp"
 #include <string_view>
 #include <ostream>
+#include <limits>
+#include <cstdint>
 
 namespace Lexer
 {
+	class Writer;
+
 	// This struct does not hold any special logic.
-	// It only accept an already calculated tag and content.
+	// It only accept an already calculated tag and content (And kind, for symbols and keywords).
 	struct Token
 	{
 		Token(Lexer::Tag new_tag);
 		Token(Lexer::Tag new_tag, const std::string_view& new_content);
+		Token(Lexer::Tag new_tag, const std::string_view& new_content, Lexer::Kind new_kind);
 
 		friend std::ostream& operator << (std::ostream& stream, const Lexer::Token& token);
 
-		const Tag tag;
-		const std::string_view content;
+		static constexpr std::uint32_t noId = std::numeric_limits<std::uint32_t>::max();
+
+		Tag tag;
+		Lexer::Kind kind = Lexer::Kind::NONE; // Which symbol or keyword (See Lexer::Kind). Right after tag, so it costs no space.
+		std::string_view content;
+		std::uint32_t id = noId; // Of the name in content, only when interned (See Lexer::Interner).
+		std::uint32_t offset = 0; // From the start of the source. Set by the lexer, also for tokens without content (Those get an empty content at their position).
+		Lexer::Literal literal = {}; // Of numbers, only when literals are decoded (See Lexer::Scanner::decodeLiterals).
+
+	private:
+		friend class Lexer::Writer;
+
+		// Slots for the printing state in every std::ostream (See std::ios_base::iword).
+		static const int indentCountIndex;
+		static const int shouldPrintIndentsIndex;
 	};
 }
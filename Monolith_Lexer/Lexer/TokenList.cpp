@@ -0,0 +1,263 @@
+#include "../Lexer/TokenList.hpp"
+#include "../Lexer/Interner.hpp"
+#include "../Lexer/TokenStream.hpp"
+#include "../Helper/Assert.hpp"
+#include <algorithm>
+
+Lexer::TokenList::Iterator::Iterator(void) : m_list(nullptr), m_index(0)
+{
+}
+Lexer::TokenList::Iterator::Iterator(const Lexer::TokenList* list, std::size_t index) : m_list(list), m_index(index)
+{
+}
+
+Lexer::Token Lexer::TokenList::Iterator::operator * (void) const
+{
+    return (*this->m_list)[this->m_index];
+}
+Lexer::Token Lexer::TokenList::Iterator::operator [] (difference_type offset) const
+{
+    return (*this->m_list)[this->m_index + offset];
+}
+
+Lexer::TokenList::Iterator& Lexer::TokenList::Iterator::operator ++ (void)
+{
+    this->m_index++;
+    return *this;
+}
+Lexer::TokenList::Iterator Lexer::TokenList::Iterator::operator ++ (int)
+{
+    Iterator old = *this;
+    this->m_index++;
+    return old;
+}
+Lexer::TokenList::Iterator& Lexer::TokenList::Iterator::operator -- (void)
+{
+    this->m_index--;
+    return *this;
+}
+Lexer::TokenList::Iterator Lexer::TokenList::Iterator::operator -- (int)
+{
+    Iterator old = *this;
+    this->m_index--;
+    return old;
+}
+Lexer::TokenList::Iterator& Lexer::TokenList::Iterator::operator += (difference_type offset)
+{
+    this->m_index += offset;
+    return *this;
+}
+Lexer::TokenList::Iterator& Lexer::TokenList::Iterator::operator -= (difference_type offset)
+{
+    this->m_index -= offset;
+    return *this;
+}
+Lexer::TokenList::Iterator Lexer::operator + (Lexer::TokenList::Iterator it, Lexer::TokenList::Iterator::difference_type offset)
+{
+    return it += offset;
+}
+Lexer::TokenList::Iterator Lexer::operator + (Lexer::TokenList::Iterator::difference_type offset, Lexer::TokenList::Iterator it)
+{
+    return it += offset;
+}
+Lexer::TokenList::Iterator Lexer::operator - (Lexer::TokenList::Iterator it, Lexer::TokenList::Iterator::difference_type offset)
+{
+    return it -= offset;
+}
+Lexer::TokenList::Iterator::difference_type Lexer::operator - (const Lexer::TokenList::Iterator& a, const Lexer::TokenList::Iterator& b)
+{
+    return static_cast<Lexer::TokenList::Iterator::difference_type>(a.m_index - b.m_index);
+}
+
+bool Lexer::TokenList::Iterator::operator == (const Iterator& other) const
+{
+    return this->m_index == other.m_index;
+}
+std::strong_ordering Lexer::TokenList::Iterator::operator <=> (const Iterator& other) const
+{
+    return this->m_index <=> other.m_index;
+}
+
+Lexer::TokenList::TokenList(const std::string_view& source, std::pmr::memory_resource* resource)
+    : m_source(source.data()), m_tags(resource), m_kinds(resource), m_offsets(resource), m_lengths(resource), m_ids(resource), m_literals(resource), m_hasLiterals(false)
+{
+}
+Lexer::TokenList::TokenList(const std::string_view& source, Lexer::TokenStream&& stream, std::pmr::memory_resource* resource)
+    : m_source(source.data()), m_tags(resource), m_kinds(resource), m_offsets(resource), m_lengths(resource), m_ids(resource), m_literals(resource), m_hasLiterals(false),
+    m_stream(std::make_shared<const Lexer::TokenStream>(std::move(stream)))
+{
+    Assert_Message(source.size() == this->m_stream->source().size(), "Stream is of another source");
+}
+
+void Lexer::TokenList::push_back(const Lexer::Token& token)
+{
+    if (this->m_stream) this->own();
+
+    // Tokens without content still point at their position (See Lexer::Token::offset). Only a Token made without any view has none.
+    this->m_tags.emplace_back(token.tag);
+    this->m_kinds.emplace_back(token.kind);
+    if (not token.content.data())
+    {
+        this->m_offsets.emplace_back(0);
+        this->m_lengths.emplace_back(0);
+    }
+    else
+    {
+        this->m_offsets.emplace_back(static_cast<std::uint32_t>(token.content.data() - this->m_source));
+        this->m_lengths.emplace_back(static_cast<std::uint32_t>(token.content.size()));
+    }
+    if (this->m_hasLiterals) this->m_literals.emplace_back(token.literal);
+}
+void Lexer::TokenList::append(const Lexer::TokenList& other)
+{
+    Assert_Message(this->m_source == other.m_source or other.empty(), "Can't append tokens of another source");
+    Assert_Message(not this->isInterned() and not other.isInterned(), "Can't append interned tokens");
+    Assert_Message(this->m_hasLiterals == other.m_hasLiterals or other.empty(), "Can't append tokens with and without literals");
+    this->own();
+
+    this->m_tags.insert(this->m_tags.end(), other.tags().begin(), other.tags().end());
+    this->m_kinds.insert(this->m_kinds.end(), other.kinds().begin(), other.kinds().end());
+    this->m_offsets.insert(this->m_offsets.end(), other.offsets().begin(), other.offsets().end());
+    this->m_lengths.insert(this->m_lengths.end(), other.lengths().begin(), other.lengths().end());
+    this->m_literals.insert(this->m_literals.end(), other.m_literals.begin(), other.m_literals.end());
+}
+void Lexer::TokenList::reserve(std::size_t count)
+{
+    this->own();
+    this->m_tags.reserve(count);
+    this->m_kinds.reserve(count);
+    this->m_offsets.reserve(count);
+    this->m_lengths.reserve(count);
+    if (this->m_hasLiterals) this->m_literals.reserve(count);
+}
+
+void Lexer::TokenList::rebase(const std::string_view& source)
+{
+    this->m_source = source.data();
+}
+void Lexer::TokenList::replace(std::size_t first, std::size_t last, const Lexer::TokenList& tokens)
+{
+    Assert_Message(first <= last and last <= this->size(), "Token range is out of the list");
+    Assert_Message(this->m_source == tokens.m_source or tokens.empty(), "Can't replace with tokens of another source");
+    Assert_Message(not this->isInterned() and not tokens.isInterned(), "Can't replace interned tokens");
+    Assert_Message(this->m_hasLiterals == tokens.m_hasLiterals or tokens.empty(), "Can't replace with tokens with or without literals");
+    this->own();
+
+    auto replaceColumn = [first, last](auto& column, const auto& other)
+    {
+        std::size_t common = std::min(last - first, other.size());
+        std::copy(other.begin(), other.begin() + common, column.begin() + first);
+        if (common < other.size()) column.insert(column.begin() + last, other.begin() + common, other.end());
+        else column.erase(column.begin() + first + common, column.begin() + last);
+    };
+    replaceColumn(this->m_tags, tokens.tags());
+    replaceColumn(this->m_kinds, tokens.kinds());
+    replaceColumn(this->m_offsets, tokens.offsets());
+    replaceColumn(this->m_lengths, tokens.lengths());
+    if (this->m_hasLiterals) replaceColumn(this->m_literals, tokens.literals());
+}
+void Lexer::TokenList::shift(std::size_t first, std::ptrdiff_t delta)
+{
+    // Every token has a position, so it's a plain add (Vectorized).
+    this->own();
+    std::uint32_t shift = static_cast<std::uint32_t>(delta);
+    for (std::size_t i = first; i < this->size(); i++)
+    {
+        this->m_offsets[i] += shift;
+    }
+}
+
+void Lexer::TokenList::keepLiterals(void)
+{
+    Assert_Message(this->empty(), "Literals are kept from the first token");
+    this->m_hasLiterals = true;
+}
+bool Lexer::TokenList::hasLiterals(void) const
+{
+    return this->m_hasLiterals;
+}
+
+void Lexer::TokenList::intern(Lexer::Interner& interner)
+{
+    Assert_Message(not this->isInterned(), "Tokens are already interned");
+    this->m_ids = interner.intern(*this);
+}
+bool Lexer::TokenList::isInterned(void) const
+{
+    return not this->ids().empty();
+}
+
+bool Lexer::TokenList::empty(void) const
+{
+    return this->tags().empty();
+}
+std::size_t Lexer::TokenList::size(void) const
+{
+    return this->tags().size();
+}
+Lexer::Token Lexer::TokenList::operator [] (std::size_t index) const
+{
+    std::span<const std::uint32_t> offsets = this->offsets();
+    Lexer::Token token(this->tags()[index], std::string_view(this->m_source + offsets[index], this->lengths()[index]), this->kinds()[index]);
+    token.offset = offsets[index];
+    if (this->isInterned()) token.id = this->ids()[index];
+    if (this->m_hasLiterals) token.literal = this->m_literals[index];
+    return token;
+}
+Lexer::TokenList::Iterator Lexer::TokenList::begin(void) const
+{
+    return Iterator(this, 0);
+}
+Lexer::TokenList::Iterator Lexer::TokenList::end(void) const
+{
+    return Iterator(this, this->size());
+}
+
+const char* Lexer::TokenList::source(void) const
+{
+    return this->m_source;
+}
+std::pmr::memory_resource* Lexer::TokenList::resource(void) const
+{
+    return this->m_tags.get_allocator().resource();
+}
+std::span<const Lexer::Tag> Lexer::TokenList::tags(void) const
+{
+    if (this->m_stream) return this->m_stream->tags();
+    return this->m_tags;
+}
+std::span<const Lexer::Kind> Lexer::TokenList::kinds(void) const
+{
+    if (this->m_stream) return this->m_stream->kinds();
+    return this->m_kinds;
+}
+std::span<const std::uint32_t> Lexer::TokenList::offsets(void) const
+{
+    if (this->m_stream) return this->m_stream->offsets();
+    return this->m_offsets;
+}
+std::span<const std::uint32_t> Lexer::TokenList::lengths(void) const
+{
+    if (this->m_stream) return this->m_stream->lengths();
+    return this->m_lengths;
+}
+std::span<const std::uint32_t> Lexer::TokenList::ids(void) const
+{
+    if (this->m_stream and this->m_ids.empty()) return this->m_stream->ids();
+    return this->m_ids;
+}
+std::span<const Lexer::Literal> Lexer::TokenList::literals(void) const
+{
+    return this->m_literals;
+}
+
+void Lexer::TokenList::own(void)
+{
+    if (not this->m_stream) return;
+    std::shared_ptr<const Lexer::TokenStream> stream = std::move(this->m_stream);
+    this->m_tags.assign(stream->tags().begin(), stream->tags().end());
+    this->m_kinds.assign(stream->kinds().begin(), stream->kinds().end());
+    this->m_offsets.assign(stream->offsets().begin(), stream->offsets().end());
+    this->m_lengths.assign(stream->lengths().begin(), stream->lengths().end());
+    if (this->m_ids.empty()) this->m_ids.assign(stream->ids().begin(), stream->ids().end());
+}
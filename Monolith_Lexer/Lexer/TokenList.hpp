@@ -0,0 +1,112 @@
+#pragma once
+#include "../Lexer/Token.hpp"
+
+#include <vector>
+#include <span>
+#include <memory>
+#include <memory_resource>
+#include <string_view>
+#include <iterator>
+#include <compare>
+#include <cstdint>
+#include <cstddef>
+
+namespace Lexer
+{
+	class Interner;
+	class TokenStream;
+
+	// Tokens stored as columns: a 1 byte tag and kind, and a 32-bit offset and length into the source.
+	// 10 bytes a token instead of 40, and a parser that only looks at tags (Or kinds) walks a plain byte array (See tags()).
+	// operator[] and the iterators make a Lexer::Token on the fly, so code that uses Tokens doesn't change.
+	class TokenList
+	{
+	public:
+		class Iterator
+		{
+		public:
+			using iterator_concept = std::random_access_iterator_tag;
+			using iterator_category = std::input_iterator_tag; // A Token is made on the fly, so there is no Token& for the old categories.
+			using value_type = Lexer::Token;
+			using difference_type = std::ptrdiff_t;
+			using reference = Lexer::Token;
+			using pointer = void;
+
+			Iterator(void);
+			Iterator(const Lexer::TokenList* list, std::size_t index);
+
+			Lexer::Token operator * (void) const;
+			Lexer::Token operator [] (difference_type offset) const;
+
+			Iterator& operator ++ (void);
+			Iterator operator ++ (int);
+			Iterator& operator -- (void);
+			Iterator operator -- (int);
+			Iterator& operator += (difference_type offset);
+			Iterator& operator -= (difference_type offset);
+			friend Iterator operator + (Iterator it, difference_type offset);
+			friend Iterator operator + (difference_type offset, Iterator it);
+			friend Iterator operator - (Iterator it, difference_type offset);
+			friend difference_type operator - (const Iterator& a, const Iterator& b);
+
+			bool operator == (const Iterator& other) const;
+			std::strong_ordering operator <=> (const Iterator& other) const;
+
+		private:
+			const Lexer::TokenList* m_list;
+			std::size_t m_index;
+		};
+
+		// Every token content must point into source. The columns are allocated from resource (An arena for example, see Helper::Arena),
+		// which must outlive the list. Moving a list into one of another resource copies the columns.
+		TokenList(const std::string_view& source = {}, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+		// Adopts the columns of stream, nothing is copied: they are read in place until the list is changed, then copied once (See own()).
+		// source must be the same text as stream.source().
+		TokenList(const std::string_view& source, Lexer::TokenStream&& stream, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+		void push_back(const Lexer::Token& token);
+		void append(const Lexer::TokenList& other); // Both must be of the same source.
+		void reserve(std::size_t count);
+
+		// For edited sources (See Lexer::Document).
+		void rebase(const std::string_view& source); // The source moved. Offsets stay the same.
+		void replace(std::size_t first, std::size_t last, const Lexer::TokenList& tokens); // Tokens [first, last) become tokens (Of the same source).
+		void shift(std::size_t first, std::ptrdiff_t delta); // Moves the offsets of the tokens from first to the end.
+
+		// Adds the literals column, before the first push_back. Then Lexer::Token::literal of every token is kept (See Lexer::Scanner::decodeLiterals).
+		void keepLiterals(void);
+		bool hasLiterals(void) const;
+
+		// Adds the name IDs column. Only once the list is complete, an interned list can't be changed anymore.
+		void intern(Lexer::Interner& interner);
+		bool isInterned(void) const;
+
+		bool empty(void) const;
+		std::size_t size(void) const;
+		Lexer::Token operator [] (std::size_t index) const;
+		Iterator begin(void) const;
+		Iterator end(void) const;
+
+		const char* source(void) const; // Where the offsets start.
+		std::pmr::memory_resource* resource(void) const;
+		std::span<const Lexer::Tag> tags(void) const;
+		std::span<const Lexer::Kind> kinds(void) const;
+		std::span<const std::uint32_t> offsets(void) const;
+		std::span<const std::uint32_t> lengths(void) const;
+		std::span<const std::uint32_t> ids(void) const; // Empty if not interned.
+		std::span<const Lexer::Literal> literals(void) const; // Empty if not kept.
+
+	private:
+		void own(void); // Copies the columns of an adopted stream into the list, before it's changed.
+
+		const char* m_source;
+		std::pmr::vector<Lexer::Tag> m_tags;
+		std::pmr::vector<Lexer::Kind> m_kinds;
+		std::pmr::vector<std::uint32_t> m_offsets;
+		std::pmr::vector<std::uint32_t> m_lengths; // 0 for tokens without content (NEW_LINE, INDENT and DEDENT), their offset is still their position.
+		std::pmr::vector<std::uint32_t> m_ids; // Empty or one for every token (See intern).
+		std::pmr::vector<Lexer::Literal> m_literals; // Empty or one for every token (See keepLiterals). Dense, so it's found in O(1) like the others.
+		bool m_hasLiterals;
+		std::shared_ptr<const Lexer::TokenStream> m_stream; // The columns (And ids, until interned) while adopted. Shared by copies, it's never changed.
+	};
+}
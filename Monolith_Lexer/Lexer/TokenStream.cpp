@@ -0,0 +1,274 @@
+#include "../Lexer/TokenStream.hpp"
+#include "../Lexer/Generator.hpp"
+#include "../Helper/Assert.hpp"
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <cstring>
+
+namespace
+{
+    enum Section : std::size_t
+    {
+        SOURCE,
+        TAGS,
+        KINDS,
+        OFFSETS,
+        LENGTHS,
+        IDS,
+        NAMES,
+        ERRORS,
+        STRINGS,
+
+        SECTION_COUNT,
+    };
+
+    constexpr char magic[8] = { 'M', 'O', 'N', 'O', 'L', 'E', 'X', '\0' };
+    constexpr std::uint32_t byteOrderMark = 0x01020304; // Reads as something else on a machine of the other byte order.
+    constexpr std::size_t alignment = 8;
+
+    struct Header
+    {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t byteOrder;
+        std::uint64_t tokensCount;
+        std::uint64_t errorsCount;
+        std::array<std::uint64_t, SECTION_COUNT> offsets; // Bytes from the start of the stream.
+        std::array<std::uint64_t, SECTION_COUNT> sizes; // Bytes.
+    };
+
+    struct ErrorEntry
+    {
+        std::uint64_t line;
+        std::uint32_t column;
+        std::uint32_t error; // Into Strings.
+        std::uint32_t code; // Into Strings.
+        std::uint32_t codeSize;
+    };
+
+    std::size_t alignUp(std::size_t size)
+    {
+        return (size + alignment - 1) / alignment * alignment;
+    }
+
+    template <typename T>
+    std::span<const T> sectionOf(const std::string_view& bytes, const Header& header, Section section)
+    {
+        return std::span<const T>(reinterpret_cast<const T*>(bytes.data() + header.offsets[section]), header.sizes[section] / sizeof(T));
+    }
+}
+
+void Lexer::TokenStream::write(std::ostream& stream, const std::string_view& source, const Lexer::TokenList& tokens, const std::vector<Lexer::Diagnostic>& errors)
+{
+    // Names, from the first token of every ID.
+    std::vector<Lexer::TokenStream::Name> names;
+    if (tokens.isInterned())
+    {
+        for (std::size_t i = 0; i < tokens.size(); i++)
+        {
+            if (tokens.ids()[i] != Lexer::Token::noId) names.emplace_back(tokens.ids()[i], tokens.offsets()[i], tokens.lengths()[i]);
+        }
+        std::stable_sort(names.begin(), names.end(), [](const Name& a, const Name& b) -> bool { return a.id < b.id; });
+        names.erase(std::unique(names.begin(), names.end(), [](const Name& a, const Name& b) -> bool { return a.id == b.id; }), names.end());
+    }
+
+    // Errors. Their texts are copied, the code of an error is not always in the source (Like a file name).
+    std::vector<ErrorEntry> entries;
+    std::string strings;
+    for (const Lexer::Diagnostic& error : errors)
+    {
+        ErrorEntry& entry = entries.emplace_back();
+        entry.line = error.line;
+        entry.column = static_cast<std::uint32_t>(error.column);
+        entry.error = static_cast<std::uint32_t>(strings.size());
+        strings.append(error.error).push_back('\0');
+        entry.code = static_cast<std::uint32_t>(strings.size());
+        entry.codeSize = static_cast<std::uint32_t>(error.code.size());
+        strings.append(error.code).push_back('\0');
+    }
+
+    std::array<std::string_view, SECTION_COUNT> sections;
+    sections[SOURCE] = source;
+    sections[TAGS] = std::string_view(reinterpret_cast<const char*>(tokens.tags().data()), tokens.size() * sizeof(Lexer::Tag));
+    sections[KINDS] = std::string_view(reinterpret_cast<const char*>(tokens.kinds().data()), tokens.size() * sizeof(Lexer::Kind));
+    sections[OFFSETS] = std::string_view(reinterpret_cast<const char*>(tokens.offsets().data()), tokens.size() * sizeof(std::uint32_t));
+    sections[LENGTHS] = std::string_view(reinterpret_cast<const char*>(tokens.lengths().data()), tokens.size() * sizeof(std::uint32_t));
+    sections[IDS] = std::string_view(reinterpret_cast<const char*>(tokens.ids().data()), tokens.ids().size() * sizeof(std::uint32_t));
+    sections[NAMES] = std::string_view(reinterpret_cast<const char*>(names.data()), names.size() * sizeof(Lexer::TokenStream::Name));
+    sections[ERRORS] = std::string_view(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(ErrorEntry));
+    sections[STRINGS] = strings;
+
+    Header header{};
+    std::copy(std::begin(magic), std::end(magic), header.magic);
+    header.version = Lexer::TokenStream::version;
+    header.byteOrder = byteOrderMark;
+    header.tokensCount = tokens.size();
+    header.errorsCount = errors.size();
+    std::size_t offset = alignUp(sizeof(Header));
+    for (std::size_t i = 0; i < SECTION_COUNT; i++)
+    {
+        header.offsets[i] = offset;
+        header.sizes[i] = sections[i].size();
+        offset = alignUp(offset + sections[i].size());
+    }
+
+    constexpr char padding[alignment] = {};
+    stream.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    stream.write(padding, static_cast<std::streamsize>(alignUp(sizeof(Header)) - sizeof(Header)));
+    for (const std::string_view& section : sections)
+    {
+        stream.write(section.data(), static_cast<std::streamsize>(section.size()));
+        stream.write(padding, static_cast<std::streamsize>(alignUp(section.size()) - section.size()));
+    }
+}
+void Lexer::TokenStream::write(std::ostream& stream, const Lexer::Generator& generator)
+{
+    Lexer::TokenStream::write(stream, generator.source(), generator.tokens(), generator.errors());
+}
+
+std::optional<Lexer::TokenStream> Lexer::TokenStream::open(const char* filename)
+{
+    Lexer::TokenStream tokenStream;
+    if (auto opt = Helper::SourceFile::open(filename))
+    {
+        tokenStream.m_file = std::move(opt.value());
+    }
+    else
+    {
+        return std::nullopt;
+    }
+
+    if (not tokenStream.load(tokenStream.m_file.view()))
+    {
+        return std::nullopt;
+    }
+    return tokenStream;
+}
+std::optional<Lexer::TokenStream> Lexer::TokenStream::view(const std::string_view& bytes)
+{
+    Lexer::TokenStream tokenStream;
+    if (not tokenStream.load(bytes))
+    {
+        return std::nullopt;
+    }
+    return tokenStream;
+}
+
+bool Lexer::TokenStream::load(const std::string_view& bytes)
+{
+    if (bytes.size() < sizeof(Header) or reinterpret_cast<std::uintptr_t>(bytes.data()) % alignment) return false;
+
+    Header header;
+    std::memcpy(&header, bytes.data(), sizeof(Header));
+    if (not std::equal(std::begin(magic), std::end(magic), header.magic)) return false;
+    if (header.version != Lexer::TokenStream::version or header.byteOrder != byteOrderMark) return false;
+
+    for (std::size_t i = 0; i < SECTION_COUNT; i++)
+    {
+        if (header.offsets[i] % alignment or header.offsets[i] > bytes.size() or header.sizes[i] > bytes.size() - header.offsets[i]) return false;
+    }
+    std::uint64_t count = header.tokensCount;
+    if (count > bytes.size() or header.errorsCount > bytes.size()) return false; // Or the sizes below could overflow.
+    if (header.sizes[SOURCE] > std::numeric_limits<std::uint32_t>::max()) return false;
+    if (header.sizes[TAGS] != count * sizeof(Lexer::Tag) or header.sizes[KINDS] != count * sizeof(Lexer::Kind)) return false;
+    if (header.sizes[OFFSETS] != count * sizeof(std::uint32_t) or header.sizes[LENGTHS] != count * sizeof(std::uint32_t)) return false;
+    if (header.sizes[IDS] != 0 and header.sizes[IDS] != count * sizeof(std::uint32_t)) return false;
+    if (header.sizes[NAMES] % sizeof(Lexer::TokenStream::Name)) return false;
+    if (header.sizes[ERRORS] != header.errorsCount * sizeof(ErrorEntry)) return false;
+    if (header.sizes[STRINGS] and bytes[header.offsets[STRINGS] + header.sizes[STRINGS] - 1] != '\0') return false;
+
+    this->m_source = bytes.substr(header.offsets[SOURCE], header.sizes[SOURCE]);
+    this->m_tags = sectionOf<Lexer::Tag>(bytes, header, TAGS);
+    this->m_kinds = sectionOf<Lexer::Kind>(bytes, header, KINDS);
+    this->m_offsets = sectionOf<std::uint32_t>(bytes, header, OFFSETS);
+    this->m_lengths = sectionOf<std::uint32_t>(bytes, header, LENGTHS);
+    this->m_ids = sectionOf<std::uint32_t>(bytes, header, IDS);
+    this->m_names = sectionOf<Lexer::TokenStream::Name>(bytes, header, NAMES);
+
+    // The columns are used without checks later (See operator [] and name()), so a bad one is caught here once.
+    for (std::size_t i = 0; i < count; i++)
+    {
+        if (this->m_tags[i] > Lexer::Tag::IDENTIFIER or this->m_kinds[i] > Lexer::Kind::TYPEDEF) return false;
+        if (this->m_offsets[i] > this->m_source.size() or this->m_lengths[i] > this->m_source.size() - this->m_offsets[i]) return false;
+    }
+    for (std::size_t i = 0; i < this->m_names.size(); i++)
+    {
+        const Lexer::TokenStream::Name& name = this->m_names[i];
+        if (name.id == Lexer::Token::noId or (i > 0 and this->m_names[i - 1].id >= name.id)) return false; // Sorted, for name().
+        if (name.offset > this->m_source.size() or name.length > this->m_source.size() - name.offset) return false;
+    }
+    for (std::uint32_t id : this->m_ids)
+    {
+        if (id != Lexer::Token::noId and not this->name(id)) return false;
+    }
+
+    // Errors are the only part that is made again.
+    std::string_view strings = bytes.substr(header.offsets[STRINGS], header.sizes[STRINGS]);
+    for (const ErrorEntry& entry : sectionOf<ErrorEntry>(bytes, header, ERRORS))
+    {
+        if (entry.error >= strings.size() or entry.code >= strings.size() or entry.codeSize >= strings.size() - entry.code) return false;
+        this->m_errors.emplace_back(entry.line, strings.data() + entry.error, strings.substr(entry.code, entry.codeSize), entry.column);
+    }
+
+    return true;
+}
+
+bool Lexer::TokenStream::empty(void) const
+{
+    return this->m_tags.empty();
+}
+std::size_t Lexer::TokenStream::size(void) const
+{
+    return this->m_tags.size();
+}
+Lexer::Token Lexer::TokenStream::operator [] (std::size_t index) const
+{
+    Lexer::Token token(this->m_tags[index], std::string_view(this->m_source.data() + this->m_offsets[index], this->m_lengths[index]), this->m_kinds[index]);
+    token.offset = this->m_offsets[index];
+    if (not this->m_ids.empty()) token.id = this->m_ids[index];
+    return token;
+}
+
+std::string_view Lexer::TokenStream::source(void) const
+{
+    return this->m_source;
+}
+std::span<const Lexer::Tag> Lexer::TokenStream::tags(void) const
+{
+    return this->m_tags;
+}
+std::span<const Lexer::Kind> Lexer::TokenStream::kinds(void) const
+{
+    return this->m_kinds;
+}
+std::span<const std::uint32_t> Lexer::TokenStream::offsets(void) const
+{
+    return this->m_offsets;
+}
+std::span<const std::uint32_t> Lexer::TokenStream::lengths(void) const
+{
+    return this->m_lengths;
+}
+std::span<const std::uint32_t> Lexer::TokenStream::ids(void) const
+{
+    return this->m_ids;
+}
+std::span<const Lexer::TokenStream::Name> Lexer::TokenStream::names(void) const
+{
+    return this->m_names;
+}
+std::optional<std::string_view> Lexer::TokenStream::name(std::uint32_t id) const
+{
+    auto it = std::lower_bound(this->m_names.begin(), this->m_names.end(), id, [](const Name& name, std::uint32_t id) -> bool
+    {
+        return name.id < id;
+    });
+    if (it == this->m_names.end() or it->id != id) return std::nullopt;
+    return std::string_view(this->m_source.data() + it->offset, it->length);
+}
+
+const std::vector<Lexer::Diagnostic>& Lexer::TokenStream::errors(void) const
+{
+    return this->m_errors;
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include "../Lexer/Token.hpp"
+#include "../Lexer/TokenList.hpp"
+#include "../Lexer/Diagnostic.hpp"
+#include "../Helper/SourceFile.hpp"
+
+#include <vector>
+#include <span>
+#include <string_view>
+#include <optional>
+#include <ostream>
+#include <cstdint>
+#include <cstddef>
+
+namespace Lexer
+{
+	class Generator;
+
+	// The binary form of a lexed source, for caches and for other processes.
+	// The columns are written exactly like Lexer::TokenList keeps them, so reading them back is mapping the file and pointing at them:
+	// Nothing is parsed or copied (Only the errors, there are few of them).
+	//
+	// Layout (Version 3, native byte order, every section starts 8 byte aligned):
+	// Header         Magic "MONOLEX\0", uint32 version, uint32 byte order mark, uint64 tokens count, uint64 errors count,
+	//                then uint64 offsets (From the start) of the 9 sections below in this order, then their uint64 sizes in bytes.
+	//                An empty section (Ids of tokens that were not interned) has size 0.
+	// Source         The source itself, so tokens can be used without it.
+	// Tags           1 byte a token.
+	// Kinds          1 byte a token (See Lexer::Kind). New in version 3.
+	// Offsets        uint32 a token, into the source. Also for tokens without content (Version 1 had 0 for them).
+	// Lengths        uint32 a token.
+	// Ids            uint32 a token, only if the tokens were interned (See Lexer::Interner). Lexer::Token::noId if it's not a name.
+	// Names          {id, offset, length} of every distinct ID, sorted by ID. The name is the source at [offset, offset + length).
+	// Errors         {uint64 line, uint32 column, uint32 error, uint32 code, uint32 code size}. error and code are offsets into Strings.
+	// Strings        NUL terminated texts of the errors.
+	//
+	// Offsets stay 32-bit (And not varints), so a token is still found in O(1) and the columns can be used in place.
+	// Everything is checked when it's read (The header, and every column once), so a bad stream is rejected and never read out of bounds.
+	class TokenStream
+	{
+	public:
+		static constexpr std::uint32_t version = 3;
+
+		struct Name
+		{
+			std::uint32_t id;
+			std::uint32_t offset;
+			std::uint32_t length;
+		};
+
+		static void write(std::ostream& stream, const std::string_view& source, const Lexer::TokenList& tokens, const std::vector<Lexer::Diagnostic>& errors);
+		static void write(std::ostream& stream, const Lexer::Generator& generator);
+
+		static std::optional<Lexer::TokenStream> open(const char* filename); // Maps the file.
+		static std::optional<Lexer::TokenStream> view(const std::string_view& bytes); // bytes must outlive it and be 8 byte aligned.
+
+		TokenStream(Lexer::TokenStream&&) noexcept = default;
+		Lexer::TokenStream& operator = (Lexer::TokenStream&&) noexcept = default;
+		TokenStream(const Lexer::TokenStream&) = delete;
+		Lexer::TokenStream& operator = (const Lexer::TokenStream&) = delete;
+
+		bool empty(void) const;
+		std::size_t size(void) const;
+		Lexer::Token operator [] (std::size_t index) const;
+
+		std::string_view source(void) const;
+		std::span<const Lexer::Tag> tags(void) const;
+		std::span<const Lexer::Kind> kinds(void) const;
+		std::span<const std::uint32_t> offsets(void) const;
+		std::span<const std::uint32_t> lengths(void) const;
+		std::span<const std::uint32_t> ids(void) const; // Empty if not interned.
+		std::span<const Lexer::TokenStream::Name> names(void) const;
+		std::optional<std::string_view> name(std::uint32_t id) const; // O(log n).
+
+		const std::vector<Lexer::Diagnostic>& errors(void) const; // Point into the stream.
+
+	private:
+		TokenStream(void) = default;
+
+		bool load(const std::string_view& bytes);
+
+		Helper::SourceFile m_file; // Empty for view().
+		std::string_view m_source;
+		std::span<const Lexer::Tag> m_tags;
+		std::span<const Lexer::Kind> m_kinds;
+		std::span<const std::uint32_t> m_offsets;
+		std::span<const std::uint32_t> m_lengths;
+		std::span<const std::uint32_t> m_ids;
+		std::span<const Lexer::TokenStream::Name> m_names;
+		std::vector<Lexer::Diagnostic> m_errors;
+	};
+}
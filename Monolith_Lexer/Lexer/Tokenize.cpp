@@ -0,0 +1,66 @@
+#include "../Lexer/Tokenize.hpp"
+#include "../Lexer/Scanner.hpp"
+#include "../Helper/SourceFile.hpp"
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <cstdint>
+
+std::generator<Lexer::Lexed> Lexer::tokenize(std::string_view source, bool shouldDecodeLiterals)
+{
+    // Tokens only keep 32-bit offsets (See Lexer::TokenList).
+    if (source.size() > std::numeric_limits<std::uint32_t>::max())
+    {
+        co_yield std::unexpected(Lexer::Diagnostic{ 0, "File is too big. 4 GiB at most", {}, 0 });
+        co_return;
+    }
+
+    constexpr std::size_t PRINTABLE_BLOCK_SIZE = 1 << 16;
+    std::size_t printableSize = 0; // The start of source that was checked.
+
+    Lexer::Scanner scanner(source);
+    if (shouldDecodeLiterals) scanner.decodeLiterals();
+    while (true)
+    {
+        std::optional<Lexer::Token> token = scanner.next();
+
+        // Nothing the scanner read is yielded before it's checked.
+        if (scanner.offset() > printableSize)
+        {
+            std::size_t size = std::max(scanner.offset() - printableSize, PRINTABLE_BLOCK_SIZE);
+            if (not Lexer::Scanner::isPrintable(source.substr(printableSize, size)))
+            {
+                co_yield std::unexpected(Lexer::Diagnostic{ 0, "Unprintable chars. UTF16 is probably used", {}, 0 });
+                co_return;
+            }
+            printableSize = std::min(printableSize + size, source.size());
+        }
+
+        // Errors of the steps that made this token, so they are before it in the source. Taken, so memory stays flat.
+        if (not scanner.errors().empty())
+        {
+            for (Lexer::Diagnostic& error : scanner.takeErrors())
+            {
+                co_yield std::unexpected(std::move(error));
+            }
+        }
+
+        if (not token) co_return;
+        co_yield Lexer::Lexed(token.value());
+    }
+}
+
+std::generator<Lexer::Lexed> Lexer::tokenizeFile(std::string filename, bool shouldDecodeLiterals)
+{
+    std::optional<Helper::SourceFile> source = Helper::SourceFile::open(filename.c_str());
+    if (not source)
+    {
+        co_yield std::unexpected(Lexer::Diagnostic{ 0, "Could not open file", filename, 0 });
+        co_return;
+    }
+
+    for (Lexer::Lexed&& lexed : Lexer::tokenize(source->view(), shouldDecodeLiterals))
+    {
+        co_yield std::move(lexed);
+    }
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include "../Lexer/Token.hpp"
+#include "../Lexer/Diagnostic.hpp"
+
+#include <generator>
+#include <expected>
+#include <string>
+#include <string_view>
+
+namespace Lexer
+{
+	// A token, or an error where it happened between the tokens.
+	using Lexed = std::expected<Lexer::Token, Lexer::Diagnostic>;
+
+	// Lazy lexing: a token is only lexed when the consumer asks for it, and nothing after the last one it took is lexed.
+	// Stopping early (A break, or destroying the generator) is free, so a tool that only reads the imports at the top of a file
+	// takes as long as those lines and not the whole file. To lex everything up front use Lexer::Generator.
+	// The tokens and errors are the same as Lexer::Generator gives, with one difference: the unprintable check (See Lexer::Scanner::isPrintable)
+	// is done a block at a time ahead of the tokens, so the tokens before a bad block still come, and then that error is the last one.
+	// Tokens and errors point into source, which must outlive them.
+	std::generator<Lexer::Lexed> tokenize(std::string_view source, bool shouldDecodeLiterals = false);
+
+	// Same for a file. It's mapped (See Helper::SourceFile) and kept by the generator, so tokens and errors are valid as long as it lives.
+	std::generator<Lexer::Lexed> tokenizeFile(std::string filename, bool shouldDecodeLiterals = false); // A copy, a coroutine outlives its arguments.
+}
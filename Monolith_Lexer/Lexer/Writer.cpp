@@ -0,0 +1,104 @@
+#include "../Lexer/Writer.hpp"
+#include "../Helper/Assert.hpp"
+#include <array>
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    constexpr std::size_t tagsCount = static_cast<std::size_t>(Lexer::Tag::IDENTIFIER) + 1;
+
+    // What is printed before the content of a token (Or all of it, for tokens without content). By Tag.
+    constexpr std::array<std::string_view, tagsCount> heads =
+    {
+        "[STRING3_LITERAL: '",
+        "[STRING_LITERAL: '",
+        "[CHAR_LITERAL: '",
+        "[HEX_LITERAL: '",
+        "[BIN_LITERAL: '",
+        "[OCT_LITERAL: '",
+        "[SCI_LITERAL: '",
+        "[FLOAT_LITERAL: '",
+        "[INT_LITERAL: '",
+        "[BOOL_LITERAL: '",
+        "[NONE_LITERAL: '",
+        "[SYMBOL: '",
+        "[KEYWORD: '",
+        "[NEW_LINE]\n",
+        "[INDENT]\n",
+        "[DEDENT]\n",
+        "[IDENTIFIER: '",
+    };
+    constexpr std::string_view tail = "'] ";
+
+    bool isLineTag(Lexer::Tag tag)
+    {
+        return tag == Lexer::Tag::NEW_LINE or tag == Lexer::Tag::INDENT or tag == Lexer::Tag::DEDENT;
+    }
+}
+
+Lexer::Writer::Writer(std::ostream& stream, std::size_t bufferSize)
+    : m_buffer(stream, bufferSize),
+    m_indentCount(stream.iword(Lexer::Token::indentCountIndex)), m_shouldPrintIndents(stream.iword(Lexer::Token::shouldPrintIndentsIndex))
+{
+}
+Lexer::Writer::~Writer(void)
+{
+    this->flush();
+}
+
+void Lexer::Writer::write(const Lexer::Token& token)
+{
+    this->writeTag(token.tag, token.content);
+}
+void Lexer::Writer::write(const Lexer::TokenList& tokens)
+{
+    // Straight from the columns, no Lexer::Token is made.
+    const char* source = tokens.source();
+    std::span<const Lexer::Tag> tags = tokens.tags();
+    std::span<const std::uint32_t> offsets = tokens.offsets();
+    std::span<const std::uint32_t> lengths = tokens.lengths();
+    for (std::size_t i = 0; i < tags.size(); i++)
+    {
+        this->writeTag(tags[i], std::string_view(source + offsets[i], lengths[i]));
+    }
+}
+void Lexer::Writer::write(const std::string_view& text)
+{
+    this->m_buffer.write(text);
+}
+void Lexer::Writer::flush(void)
+{
+    this->m_buffer.flush();
+    this->m_buffer.stream().iword(Lexer::Token::indentCountIndex) = this->m_indentCount;
+    this->m_buffer.stream().iword(Lexer::Token::shouldPrintIndentsIndex) = this->m_shouldPrintIndents;
+}
+
+void Lexer::Writer::writeTag(Lexer::Tag tag, const std::string_view& content)
+{
+    // Same as operator << (Lexer::Token): Tabs only after a token without content, and only those change the indention.
+    Assert_Message(static_cast<std::size_t>(tag) < tagsCount, std::format("Unknown Tag: {}", static_cast<int>(tag)));
+
+    bool isLine = isLineTag(tag);
+    std::size_t tabsCount = 0;
+    if (this->m_shouldPrintIndents)
+    {
+        if (tag == Lexer::Tag::INDENT) this->m_indentCount++;
+        else if (tag == Lexer::Tag::DEDENT) this->m_indentCount--;
+        tabsCount = static_cast<std::size_t>(std::max(this->m_indentCount, 0L));
+    }
+    this->m_shouldPrintIndents = isLine;
+
+    // Only the small pieces are reserved. The content is written on its own, so a huge literal goes through in pieces
+    // and doesn't grow the buffer for the rest of its life (See Helper::OutputBuffer::write).
+    std::string_view head = heads[static_cast<std::size_t>(tag)];
+    std::size_t size = tabsCount + head.size();
+    char* out = this->m_buffer.reserve(size);
+    std::memset(out, '\t', tabsCount);
+    std::memcpy(out + tabsCount, head.data(), head.size());
+    this->m_buffer.commit(size);
+    if (isLine) return;
+
+    this->m_buffer.write(content);
+    this->m_buffer.write(tail);
+}
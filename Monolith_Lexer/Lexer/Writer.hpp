@@ -0,0 +1,35 @@
+#pragma once
+#include "../Lexer/Token.hpp"
+#include "../Lexer/TokenList.hpp"
+#include "../Helper/OutputBuffer.hpp"
+
+#include <string_view>
+#include <ostream>
+#include <cstddef>
+
+namespace Lexer
+{
+	// Writes tokens in the exact format of operator << (Lexer::Token), without a stream call for every piece of every token.
+	// Everything is formatted into one buffer (See Helper::OutputBuffer) with memcpy and tables of the tag names.
+	// The indention state is the same one operator << keeps inside the stream, so both can be mixed on one stream (flush() before using it).
+	class Writer
+	{
+	public:
+		Writer(std::ostream& stream, std::size_t bufferSize = 1 << 20);
+		Writer(const Lexer::Writer&) = delete;
+		Lexer::Writer& operator = (const Lexer::Writer&) = delete;
+		~Writer(void); // Flushes.
+
+		void write(const Lexer::Token& token);
+		void write(const Lexer::TokenList& tokens);
+		void write(const std::string_view& text);
+		void flush(void);
+
+	private:
+		void writeTag(Lexer::Tag tag, const std::string_view& content);
+
+		Helper::OutputBuffer m_buffer;
+		long m_indentCount; // Copies of the state inside m_stream, it's only read and written back by the constructor and flush().
+		bool m_shouldPrintIndents;
+	};
+}
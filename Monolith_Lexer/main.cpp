@@ -1,22 +1,271 @@
 #include "Lexer/Generator.hpp"
+#include "Lexer/TokenStream.hpp"
+#include "Lexer/JsonWriter.hpp"
+#include "Driver/Batch.hpp"
+#include "Driver/Server.hpp"
 #include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <filesystem>
+#include <optional>
+#include <thread>
+#include <charconv>
+#include <limits>
+#include <cstdint>
+
+// Usage:
+// Project [--jobs N] [--stats] [--format lex|binary|json] [--decode] [--cache DIRECTORY [--cache-size MB]] [input.mon] [output.lex]
+// --format binary writes the tokens in the binary form of Lexer::TokenStream instead of text, json writes JSON Lines (See Lexer::JsonWriter).
+// --decode decodes the value of every number while lexing (json writes it as "value"), and a number that doesn't fit is an error.
+// --cache keeps lexed sources in DIRECTORY, so unchanged ones are not lexed again (See Lexer::Cache). 1024 MB at most by default.
+// Project --batch <output directory> [--jobs N] [--intern] [--cache DIRECTORY [--cache-size MB]] <file or directory>...
+// Project --serve <socket path> [--jobs N] [--intern] [--cache DIRECTORY [--cache-size MB]]
+// --serve lexes what clients send over a Unix domain socket until one sends SHUTDOWN (See Driver::Server for the requests).
+static constexpr std::string_view lexUsage = " [--jobs N] [--stats] [--format lex|binary|json] [--decode] [--cache DIRECTORY [--cache-size MB]] [input.mon] [output.lex]";
+static constexpr std::string_view batchUsage = " --batch <output directory> [--jobs N] [--intern] [--cache DIRECTORY [--cache-size MB]] <file or directory>...";
+static constexpr std::string_view serveUsage = " --serve <socket path> [--jobs N] [--intern] [--cache DIRECTORY [--cache-size MB]]";
+
+static int printUsage(const char* program, std::string_view usage)
+{
+    std::cerr << "Usage: " << program << usage << '\n';
+    return 1;
+}
+
+// A whole number. std::nullopt on anything else, also a sign (std::stoul throws, and takes "-1" as a huge number).
+static std::optional<std::size_t> parseCount(std::string_view text)
+{
+    std::size_t count = 0;
+    auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), count);
+    if (error != std::errc() or end != text.data() + text.size()) return std::nullopt;
+    return count;
+}
+
+// Megabytes (A fraction too) in bytes. std::nullopt if it's not a number, negative, or doesn't fit.
+static std::optional<std::uintmax_t> parseMegabytes(std::string_view text)
+{
+    double megabytes = 0;
+    auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), megabytes);
+    if (error != std::errc() or end != text.data() + text.size()) return std::nullopt;
+    double bytes = megabytes * (1 << 20);
+    if (not (bytes >= 0) or bytes >= static_cast<double>(std::numeric_limits<std::uintmax_t>::max())) return std::nullopt; // Also NaN.
+    return static_cast<std::uintmax_t>(bytes);
+}
+
+static int runBatch(int argc, char** argv)
+{
+    if (argc < 4)
+    {
+        return printUsage(argv[0], batchUsage);
+    }
+
+    std::filesystem::path outputDirectory = argv[2];
+    std::vector<std::filesystem::path> inputs;
+    std::size_t threadCount = std::thread::hardware_concurrency();
+    bool shouldIntern = false;
+    std::filesystem::path cacheDirectory;
+    std::uintmax_t cacheSize = std::uintmax_t(1) << 30;
+    for (int i = 3; i < argc; i++)
+    {
+        if (std::string_view(argv[i]) == "--jobs" and i + 1 < argc)
+        {
+            auto count = parseCount(argv[++i]);
+            if (not count) return printUsage(argv[0], batchUsage);
+            threadCount = count.value();
+            continue;
+        }
+        if (std::string_view(argv[i]) == "--intern")
+        {
+            shouldIntern = true;
+            continue;
+        }
+        if (std::string_view(argv[i]) == "--cache" and i + 1 < argc)
+        {
+            cacheDirectory = argv[++i];
+            continue;
+        }
+        if (std::string_view(argv[i]) == "--cache-size" and i + 1 < argc)
+        {
+            auto size = parseMegabytes(argv[++i]);
+            if (not size) return printUsage(argv[0], batchUsage);
+            cacheSize = size.value();
+            continue;
+        }
+        if (std::string_view(argv[i]).starts_with("--"))
+        {
+            std::cerr << "Unknown option: " << argv[i] << '\n';
+            return 1;
+        }
+        inputs.emplace_back(argv[i]);
+    }
+
+    Lexer::Interner interner;
+    std::optional<Lexer::Cache> cache;
+    if (not cacheDirectory.empty()) cache.emplace(cacheDirectory, cacheSize);
+
+    Driver::Batch batch(outputDirectory, inputs, threadCount, shouldIntern ? &interner : nullptr, cache ? &cache.value() : nullptr);
+    std::cout << batch;
+    if (cache) cache->trim();
+    return batch.didPass() ? 0 : 1;
+}
+
+static int runServer(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        return printUsage(argv[0], serveUsage);
+    }
+
+    std::filesystem::path socketPath = argv[2];
+    std::size_t threadCount = std::thread::hardware_concurrency();
+    bool shouldIntern = false;
+    std::filesystem::path cacheDirectory;
+    std::uintmax_t cacheSize = std::uintmax_t(1) << 30;
+    for (int i = 3; i < argc; i++)
+    {
+        if (std::string_view(argv[i]) == "--jobs" and i + 1 < argc)
+        {
+            auto count = parseCount(argv[++i]);
+            if (not count) return printUsage(argv[0], serveUsage);
+            threadCount = count.value();
+        }
+        else if (std::string_view(argv[i]) == "--intern")
+        {
+            shouldIntern = true;
+        }
+        else if (std::string_view(argv[i]) == "--cache" and i + 1 < argc)
+        {
+            cacheDirectory = argv[++i];
+        }
+        else if (std::string_view(argv[i]) == "--cache-size" and i + 1 < argc)
+        {
+            auto size = parseMegabytes(argv[++i]);
+            if (not size) return printUsage(argv[0], serveUsage);
+            cacheSize = size.value();
+        }
+        else
+        {
+            std::cerr << "Unknown option: " << argv[i] << '\n';
+            return 1;
+        }
+    }
+
+    // Shared by every request, so they stay warm between them.
+    Lexer::Interner interner;
+    std::optional<Lexer::Cache> cache;
+    if (not cacheDirectory.empty()) cache.emplace(cacheDirectory, cacheSize);
+
+    Driver::Server server(socketPath, threadCount, shouldIntern ? &interner : nullptr, cache ? &cache.value() : nullptr);
+    bool success = server.run();
+    if (not success) std::cerr << server.error() << '\n';
+    if (cache) cache->trim();
+    return success ? 0 : 1;
+}
 
 int main(int argc, char** argv)
 {
+    if (argc >= 2 and std::string_view(argv[1]) == "--batch")
+    {
+        return runBatch(argc, argv);
+    }
+    if (argc >= 2 and std::string_view(argv[1]) == "--serve")
+    {
+        return runServer(argc, argv);
+    }
+
     const char* inputFileName = "../TestIO/input.mon";
     const char* outputFileName = "../TestIO/output.lex";
+    std::size_t threadCount = 1;
+    bool shouldPrintStats = false;
+    std::string_view format = "lex";
+    bool shouldDecodeLiterals = false;
+    std::filesystem::path cacheDirectory;
+    std::uintmax_t cacheSize = std::uintmax_t(1) << 30;
+
+    int first = 1;
+    while (first < argc)
+    {
+        if (std::string_view(argv[first]) == "--jobs" and first + 1 < argc)
+        {
+            auto count = parseCount(argv[first + 1]);
+            if (not count) return printUsage(argv[0], lexUsage);
+            threadCount = count.value();
+            first += 2;
+        }
+        else if (std::string_view(argv[first]) == "--stats")
+        {
+            shouldPrintStats = true;
+            first++;
+        }
+        else if (std::string_view(argv[first]) == "--format" and first + 1 < argc)
+        {
+            format = argv[first + 1];
+            if (format != "lex" and format != "binary" and format != "json")
+            {
+                std::cerr << "Unknown format: " << format << '\n';
+                return 1;
+            }
+            first += 2;
+        }
+        else if (std::string_view(argv[first]) == "--decode")
+        {
+            shouldDecodeLiterals = true;
+            first++;
+        }
+        else if (std::string_view(argv[first]) == "--cache" and first + 1 < argc)
+        {
+            cacheDirectory = argv[first + 1];
+            first += 2;
+        }
+        else if (std::string_view(argv[first]) == "--cache-size" and first + 1 < argc)
+        {
+            auto size = parseMegabytes(argv[first + 1]);
+            if (not size) return printUsage(argv[0], lexUsage);
+            cacheSize = size.value();
+            first += 2;
+        }
+        else
+        {
+            break;
+        }
+    }
+    if (argc >= first + 1)
+    {
+        inputFileName = argv[first];
+    }
+    if (argc >= first + 2)
+    {
+        outputFileName = argv[first + 1];
+    }
+
+    std::optional<Lexer::Cache> cache;
+    if (not cacheDirectory.empty()) cache.emplace(cacheDirectory, cacheSize);
 
-    if (argc >= 2)
+    Lexer::Generator lexer(inputFileName, threadCount, nullptr, cache ? &cache.value() : nullptr, shouldDecodeLiterals);
+    if (format == "binary")
     {
-        inputFileName = argv[1];
+        std::fstream output(outputFileName, std::ios::out | std::ios::trunc | std::ios::binary);
+        Lexer::TokenStream::write(output, lexer);
     }
-    if (argc >= 3)
+    else if (format == "json")
     {
-        outputFileName = argv[2];
+        std::fstream output(outputFileName, std::ios::out | std::ios::trunc | std::ios::binary);
+        Lexer::JsonWriter(output).write(lexer);
+    }
+    else
+    {
+        std::fstream output(outputFileName, std::ios::out | std::ios::trunc);
+        output << lexer;
     }
 
-    Lexer::Generator lexer(inputFileName);
-    std::fstream output(outputFileName, std::ios::out | std::ios::trunc);
-    output << lexer;
+    if (cache)
+    {
+        cache->trim();
+    }
+    if (shouldPrintStats)
+    {
+        std::cout << lexer.stats();
+    }
     return 0;
-}
\ No newline at end of file
+}